@@ -606,6 +606,9 @@ function g_map.findEveryPath(start, maxDistance, params) end
 ---@return Creature[]
 function g_map.getSpectatorsByPattern(centerPos, pattern, direction) end
 
+---@return table<string, number>
+function g_map.getMemoryReport() end
+
 --------------------------------
 ---------- g_minimap -----------
 --------------------------------
@@ -2755,9 +2758,8 @@ function Tile:isSelected() end
 function Tile:isCovered(firstFloor) end
 
 ---@param firstFloor integer
----@param resetCache boolean
 ---@return boolean
-function Tile:isCompletelyCovered(firstFloor, resetCache) end
+function Tile:isCompletelyCovered(firstFloor) end
 
 ---@param text string
 ---@param color Color | string
@@ -3382,6 +3384,20 @@ function g_app.setTargetFps(targetFps) end
 
 function g_app.resetTargetFps() end
 
+---@param mapThread boolean
+---@return table<string, number>
+function g_app.getFrameTimeStats(mapThread) end
+
+---@param mapThread boolean
+---@return table<string, number>[]
+function g_app.getWorstFrames(mapThread) end
+
+---@return integer
+function g_app.getSlowFrameThreshold() end
+
+---@param millis integer
+function g_app.setSlowFrameThreshold(millis) end
+
 ---@return boolean
 function g_app.isDrawingTexts() end
 
@@ -47,6 +47,33 @@ function toggle()
     end
 end
 
+local function formatFrameTimes(name, stats)
+    return string.format('%s - p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.1f ms (%d frames, %d slow)', name,
+        stats.p50, stats.p95, stats.p99, stats.max, stats.frames, stats.slowFrames)
+end
+
+-- each slow frame with the phases that took longest during it
+local function formatWorstFrames(name, frames)
+    local text = ''
+    for _, frame in ipairs(frames) do
+        local phases = {}
+        for phase, ms in pairs(frame) do
+            if phase ~= 'ms' and phase ~= 'age' then
+                table.insert(phases, { name = phase, ms = ms })
+            end
+        end
+        table.sort(phases, function(a, b) return a.ms > b.ms end)
+
+        local parts = {}
+        for i = 1, math.min(#phases, 4) do
+            table.insert(parts, string.format('%s %.1f', phases[i].name, phases[i].ms))
+        end
+        text = text .. string.format('%s %.1f ms, %ds ago: %s\n', name, frame.ms, math.floor(frame.age / 1000),
+            table.concat(parts, ', '))
+    end
+    return text
+end
+
 function update()
     updateEvent = scheduleEvent(update, 20)
 
@@ -62,4 +89,11 @@ function update()
         end
         debugInfoWindow.debugPanel.proxies:setText(text)
     end
+
+    debugInfoWindow.debugPanel.frameTimes:setText(formatFrameTimes('Render', g_app.getFrameTimeStats(false)) .. '\n' ..
+        formatFrameTimes('Map', g_app.getFrameTimeStats(true)))
+
+    local slowFrames = formatWorstFrames('Render', g_app.getWorstFrames(false)) ..
+        formatWorstFrames('Map', g_app.getWorstFrames(true))
+    debugInfoWindow.debugPanel.slowFrames:setText(slowFrames ~= '' and slowFrames or '-')
 end
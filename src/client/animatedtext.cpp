@@ -25,8 +25,8 @@
 #include "game.h"
 #include "gameconfig.h"
 #include "map.h"
-#include "framework/core/eventdispatcher.h"
 #include "framework/core/graphicalapplication.h"
+#include "framework/graphics/textbatch.h"
 
 AnimatedText::AnimatedText()
 {
@@ -34,7 +34,12 @@ AnimatedText::AnimatedText()
     m_cachedText.setAlign(Fw::AlignLeft);
 }
 
-void AnimatedText::drawText(const Point& dest, const Rect& visibleRect)
+AnimatedTextPtr AnimatedText::create(const std::string_view text, const int color)
+{
+    return std::allocate_shared<AnimatedText>(stdext::recycling_allocator<AnimatedText>(), text, color);
+}
+
+void AnimatedText::drawText(const Point& dest, const Rect& visibleRect, TextBatch& batch)
 {
     const float tf = g_gameConfig.getAnimatedTextDuration(),
         tftf = g_gameConfig.getAnimatedTextDuration() * g_gameConfig.getAnimatedTextDuration();
@@ -61,22 +66,20 @@ void AnimatedText::drawText(const Point& dest, const Rect& visibleRect)
 
     Color color = m_color;
     if (t > t0) {
-        color.setAlpha(1 - (t - t0) / (tf - t0));
+        // stepped fade, so texts fading together still share a batch group
+        color.setAlpha(std::ceil((1 - (t - t0) / (tf - t0)) * 32.f) / 32.f);
     }
 
-    m_cachedText.draw(rect, color);
+    batch.add(m_cachedText, rect, color);
 }
 
 void AnimatedText::onAppear()
 {
     m_animationTimer.restart();
 
-    uint16_t textDuration = g_gameConfig.getAnimatedTextDuration();
+    m_duration = g_gameConfig.getAnimatedTextDuration();
     if (g_app.mustOptimize())
-        textDuration /= 2;
-
-    // schedule removal
-    g_textDispatcher.scheduleEvent([self = asAnimatedText()] { g_map.removeAnimatedText(self); }, textDuration);
+        m_duration /= 2;
 }
 
 bool AnimatedText::merge(const AnimatedTextPtr& other)
@@ -87,7 +90,7 @@ bool AnimatedText::merge(const AnimatedTextPtr& other)
     if (other->getCachedText().getFont() != m_cachedText.getFont())
         return false;
 
-    if (m_animationTimer.ticksElapsed() > g_gameConfig.getAnimatedTextDuration() / 2.5)
+    if (m_animationTimer.ticksElapsed() > g_gameConfig.getAnimatedTextMergeWindow())
         return false;
 
     try {
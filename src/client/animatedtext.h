@@ -38,9 +38,12 @@ public:
         setColor(color);
     }
 
-    void drawText(const Point& dest, const Rect& visibleRect);
+    static AnimatedTextPtr create(std::string_view text, int color);
+
+    void drawText(const Point& dest, const Rect& visibleRect, TextBatch& batch);
 
     void onAppear();
+    bool isExpired() const { return m_animationTimer.ticksElapsed() >= m_duration; }
 
     void setColor(const int color) { m_color = Color::from8bit(color); }
     void setText(const std::string_view text) { m_cachedText.setText(text); }
@@ -64,4 +67,6 @@ private:
     CachedText m_cachedText;
     Point m_offset;
     Position m_position;
+
+    uint16_t m_duration{ 0 };
 };
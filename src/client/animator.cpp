@@ -76,6 +76,40 @@ void Animator::serialize(const FileStreamPtr& fin) const
     }
 }
 
+void Animator::serializeSnapshot(const FileStreamPtr& fin) const
+{
+    fin->addU16(m_animationPhases);
+    fin->addU8(m_async);
+    fin->add8(m_loopCount);
+    fin->add8(m_startPhase);
+    fin->addU8(m_phase);
+    fin->addU16(m_minDuration);
+
+    fin->addU16(m_phaseDurations.size());
+    for (const auto& [min, max] : m_phaseDurations) {
+        fin->addU16(min);
+        fin->addU16(max);
+    }
+}
+
+void Animator::unserializeSnapshot(const FileStreamPtr& fin)
+{
+    m_animationPhases = fin->getU16();
+    m_async = fin->getU8() != 0;
+    m_loopCount = fin->get8();
+    m_startPhase = fin->get8();
+    m_phase = fin->getU8();
+    m_minDuration = fin->getU16();
+
+    const uint16_t count = fin->getU16();
+    m_phaseDurations.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const uint16_t min = fin->getU16();
+        const uint16_t max = fin->getU16();
+        m_phaseDurations.emplace_back(min, max);
+    }
+}
+
 void Animator::setPhase(const int phase)
 {
     if (m_phase == phase)
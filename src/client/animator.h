@@ -48,6 +48,8 @@ public:
     void unserializeAppearance(const appearances::SpriteAnimation& animation);
     void unserialize(int animationPhases, const FileStreamPtr& fin);
     void serialize(const FileStreamPtr& fin) const;
+    void serializeSnapshot(const FileStreamPtr& fin) const;
+    void unserializeSnapshot(const FileStreamPtr& fin);
     void setPhase(int phase);
     void resetAnimation();
 
@@ -27,6 +27,7 @@
 #include "map.h"
 #include "mapview.h"
 #include "minimap.h"
+#include "outfitcache.h"
 #include "spriteappearances.h"
 #include "spritemanager.h"
 #include "thingtypemanager.h"
@@ -66,6 +67,7 @@ void Client::terminate()
     g_game.terminate();
     g_map.terminate();
     g_minimap.terminate();
+    g_outfitCache.terminate();
     g_things.terminate();
     g_sprites.terminate();
     g_spriteAppearances.terminate();
@@ -74,6 +76,8 @@ void Client::terminate()
 }
 
 void Client::preLoad() {
+    g_map.removeExpiredThings();
+
     if (m_mapWidget) {
         if (m_mapWidget->isDestroyed())
             m_mapWidget = nullptr;
@@ -108,6 +112,7 @@ void Client::draw(const DrawPoolType type)
 
     if (type == DrawPoolType::FOREGROUND_MAP) {
         g_textDispatcher.poll();
+        g_map.removeExpiredAnimatedTexts();
         m_mapWidget->draw(DrawPoolType::CREATURE_INFORMATION);
     }
 
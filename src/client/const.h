@@ -1316,6 +1316,13 @@ enum
     BLOCK_SIZE = 32
 };
 
+enum TileOcclusion : uint8_t
+{
+    OCCLUSION_OPAQUE = 1 << 0,
+    OCCLUSION_TOP_GROUND = 1 << 1,
+    OCCLUSION_PENDING = 1 << 2 // opacity is only known once the textures were loaded
+};
+
 enum : uint8_t
 {
     Animation_Force,
@@ -24,12 +24,14 @@
 
 #include "animator.h"
 #include "attachedeffect.h"
+#include "creatureinformationbatch.h"
 #include "game.h"
 #include "gameconfig.h"
 #include "lightview.h"
 #include "localplayer.h"
 #include "luavaluecasts_client.h"
 #include "map.h"
+#include "outfitcache.h"
 #include "framework/graphics/texturemanager.h"
 #include "protocolcodes.h"
 #include "statictext.h"
@@ -148,7 +150,7 @@ void Creature::draw(const Rect& destRect, const uint8_t size, const bool center)
     g_drawPool.releaseFrameBuffer(out);
 }
 
-void Creature::drawInformation(const MapPosInfo& mapRect, const Point& dest, const int drawFlags)
+void Creature::drawInformation(const MapPosInfo& mapRect, const Point& dest, const int drawFlags, CreatureInformationBatch& batch)
 {
     static constexpr Color
         DEFAULT_COLOR(96, 96, 96),
@@ -220,81 +222,79 @@ void Creature::drawInformation(const MapPosInfo& mapRect, const Point& dest, con
     Rect barsRect = backgroundRect;
 
     if ((drawFlags & Otc::DrawBars) && (g_game.getClientVersion() >= 1100 ? !isNpc() : true)) {
-        g_drawPool.addFilledRect(backgroundRect, Color::black);
-        g_drawPool.addFilledRect(healthRect, fillColor);
+        batch.addBar(backgroundRect, Color::black);
+        batch.addBar(healthRect, fillColor);
 
         if (drawFlags & Otc::DrawManaBar && isLocalPlayer()) {
             if (const auto& player = g_game.getLocalPlayer()) {
                 if (player->isMage() && player->getMaxManaShield() > 0) {
                     barsRect.moveTop(barsRect.bottom());
-                    g_drawPool.addFilledRect(barsRect, Color::black);
+                    batch.addBar(barsRect, Color::black);
 
                     Rect manaShieldRect = barsRect.expanded(-1);
                     const double maxManaShield = player->getMaxManaShield();
                     manaShieldRect.setWidth((maxManaShield ? player->getManaShield() / maxManaShield : 1) * 25);
 
-                    g_drawPool.addFilledRect(manaShieldRect, Color::darkPink);
+                    batch.addBar(manaShieldRect, Color::darkPink);
                 }
 
                 barsRect.moveTop(barsRect.bottom());
-                g_drawPool.addFilledRect(barsRect, Color::black);
+                batch.addBar(barsRect, Color::black);
 
                 Rect manaRect = barsRect.expanded(-1);
                 const double maxMana = player->getMaxMana();
                 manaRect.setWidth((maxMana ? player->getMana() / maxMana : 1) * 25);
 
-                g_drawPool.addFilledRect(manaRect, Color::blue);
+                batch.addBar(manaRect, Color::blue);
             }
         }
 
         backgroundRect = barsRect;
     }
 
-    g_drawPool.setDrawOrder(DrawOrder::SECOND);
-
     if (drawFlags & Otc::DrawNames) {
-        m_name.draw(textRect, fillColor);
+        batch.addText(m_name, textRect, fillColor);
 
         if (m_text) {
             auto extraTextSize = m_text->getTextSize();
             Rect extraTextRect = Rect(p.x - extraTextSize.width() / 2.0, p.y + 15, extraTextSize);
+            g_drawPool.setDrawOrder(DrawOrder::SECOND);
             m_text->drawText(extraTextRect.center(), extraTextRect);
+            g_drawPool.resetDrawOrder();
         }
     }
 
     if (m_skull != Otc::SkullNone && m_skullTexture)
-        g_drawPool.addTexturedPos(m_skullTexture, backgroundRect.x() + 13.5 + 12, backgroundRect.y() + 5);
+        batch.addIcon(m_skullTexture, backgroundRect.x() + 13.5 + 12, backgroundRect.y() + 5);
 
     if (m_shield != Otc::ShieldNone && m_shieldTexture && m_showShieldTexture)
-        g_drawPool.addTexturedPos(m_shieldTexture, backgroundRect.x() + 13.5, backgroundRect.y() + 5);
+        batch.addIcon(m_shieldTexture, backgroundRect.x() + 13.5, backgroundRect.y() + 5);
 
     if (m_emblem != Otc::EmblemNone && m_emblemTexture)
-        g_drawPool.addTexturedPos(m_emblemTexture, backgroundRect.x() + 13.5 + 12, backgroundRect.y() + 16);
+        batch.addIcon(m_emblemTexture, backgroundRect.x() + 13.5 + 12, backgroundRect.y() + 16);
 
     if (m_type != Proto::CreatureTypeUnknown && m_typeTexture)
-        g_drawPool.addTexturedPos(m_typeTexture, backgroundRect.x() + 13.5 + 12 + 12, backgroundRect.y() + 16);
+        batch.addIcon(m_typeTexture, backgroundRect.x() + 13.5 + 12 + 12, backgroundRect.y() + 16);
 
     if (m_icon != Otc::NpcIconNone && m_iconTexture)
-        g_drawPool.addTexturedPos(m_iconTexture, backgroundRect.x() + 13.5 + 12, backgroundRect.y() + 5);
+        batch.addIcon(m_iconTexture, backgroundRect.x() + 13.5 + 12, backgroundRect.y() + 5);
 
     if (g_gameConfig.drawTyping() && getTyping() && m_typingIconTexture)
-        g_drawPool.addTexturedPos(m_typingIconTexture, p.x + (nameSize.width() / 2.0) + 2, textRect.y() - 4);
+        batch.addIcon(m_typingIconTexture, p.x + (nameSize.width() / 2.0) + 2, textRect.y() - 4);
 
     if (g_game.getClientVersion() >= 1281 && m_icons && !m_icons->atlasGroups.empty()) {
         int iconOffset = 0;
         for (const auto& iconTex : m_icons->atlasGroups) {
             if (!iconTex.texture) continue;
             const Rect dest(backgroundRect.x() + 13.5 + 12, backgroundRect.y() + 5 + iconOffset * 14, iconTex.clip.size());
-            g_drawPool.addTexturedRect(dest, iconTex.texture, iconTex.clip);
+            batch.addIcon(iconTex.texture, dest, iconTex.clip);
             m_icons->numberText.setText(std::to_string(iconTex.count));
             const auto textSize = m_icons->numberText.getTextSize();
             const Rect numberRect(dest.right() + 2, dest.y() + (dest.height() - textSize.height()) / 2, textSize);
-            m_icons->numberText.draw(numberRect, Color::white);
+            batch.addText(m_icons->numberText, numberRect, Color::white);
             ++iconOffset;
         }
     }
-
-    g_drawPool.resetDrawOrder();
 }
 
 void Creature::internalDraw(Point dest, const Color& color)
@@ -343,6 +343,14 @@ void Creature::internalDraw(Point dest, const Color& color)
             const bool useFramebuffer = !replaceColorShader && hasShader() && g_shaders.getShaderById(m_shaderId)->useFramebuffer();
 
             const auto& drawCreature = [&](const Point& dest) {
+                // identically dressed creatures share one composed frame instead of a base and four masks per addon
+                if (m_drawOutfitColor && !replaceColorShader && !hasShader() && getLayers() > 1) {
+                    if (const auto& frame = g_outfitCache.getFrame(datType, m_outfit, m_numPatternX, m_numPatternZ, animationPhase)) {
+                        datType->drawComposedFrame(dest, frame, color);
+                        return;
+                    }
+                }
+
                 // yPattern => creature addon
                 for (int yPattern = 0; yPattern < getNumPatternY(); ++yPattern) {
                     // continue if we dont have this addon
@@ -1293,7 +1301,7 @@ void Creature::setCovered(bool covered) {
 void Creature::setText(const std::string& text, const Color& color)
 {
     if (!m_text) {
-        m_text = std::make_shared<StaticText>();
+        m_text = StaticText::create();
     }
     m_text->setText(text);
     m_text->setColor(color);
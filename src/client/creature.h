@@ -53,7 +53,7 @@ public:
     void drawLight(const Point& dest, LightView* lightView) override;
 
     void internalDraw(Point dest, const Color& color = Color::white);
-    void drawInformation(const MapPosInfo& mapRect, const Point& dest, int drawFlags);
+    void drawInformation(const MapPosInfo& mapRect, const Point& dest, int drawFlags, CreatureInformationBatch& batch);
 
     void setId(const uint32_t id) override { m_id = id; }
     void setMasterId(const uint32_t id) { m_masterId = id; }
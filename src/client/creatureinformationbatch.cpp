@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "creatureinformationbatch.h"
+
+#include <framework/graphics/coordsbuffer.h>
+#include <framework/graphics/drawpoolmanager.h>
+#include <framework/graphics/texture.h>
+
+void CreatureInformationBatch::addBar(const Rect& dest, const Color& color)
+{
+    if (dest.isEmpty())
+        return;
+
+    getCoords(m_bars, nullptr, nullptr, color).addRect(dest);
+}
+
+void CreatureInformationBatch::addText(CachedText& text, const Rect& dest, const Color& color)
+{
+    m_texts.add(text, dest, color);
+}
+
+void CreatureInformationBatch::addIcon(const TexturePtr& texture, const Rect& dest, const Rect& src)
+{
+    if (!texture || dest.isEmpty() || src.isEmpty())
+        return;
+
+    // icons sharing an atlas layer are drawn together, any of them stands for the layer
+    const auto* region = texture->getAtlasRegion();
+    if (!region) {
+        m_looseIcons.emplace_back(texture, dest, src);
+        return;
+    }
+
+    getCoords(m_icons, texture, region->atlas, Color::white).addRect(dest, src.translated(region->x, region->y));
+}
+
+void CreatureInformationBatch::addIcon(const TexturePtr& texture, const int x, const int y)
+{
+    if (texture)
+        addIcon(texture, Rect(x, y, texture->getSize()), Rect(Point(), texture->getSize()));
+}
+
+void CreatureInformationBatch::draw()
+{
+    drawGroups(m_bars);
+
+    g_drawPool.setDrawOrder(DrawOrder::SECOND);
+
+    m_texts.draw();
+    drawGroups(m_icons);
+
+    for (const auto& icon : m_looseIcons)
+        g_drawPool.addTexturedRect(icon.dest, icon.texture, icon.src);
+    m_looseIcons.clear();
+
+    g_drawPool.resetDrawOrder();
+}
+
+CoordsBuffer& CreatureInformationBatch::getCoords(std::vector<Group>& groups, const TexturePtr& texture, const Texture* key, const Color& color)
+{
+    auto it = std::find_if(groups.begin(), groups.end(), [key, &color](const Group& group) {
+        return group.key == key && group.color == color;
+    });
+
+    if (it == groups.end())
+        it = groups.insert(groups.end(), Group{ .key = key, .color = color, .coords = std::make_shared<CoordsBuffer>() });
+
+    // the first texture added this frame, a previous one may have left the atlas since
+    if (it->coords->getVertexCount() == 0)
+        it->texture = texture;
+
+    return *it->coords;
+}
+
+void CreatureInformationBatch::drawGroups(std::vector<Group>& groups)
+{
+    // groups left empty this frame are gone from the screen
+    std::erase_if(groups, [](const Group& group) { return group.coords->getVertexCount() == 0; });
+
+    for (const auto& group : groups) {
+        g_drawPool.addTexturedCoordsBuffer(group.texture, group.coords, group.color);
+        group.coords->clear();
+    }
+}
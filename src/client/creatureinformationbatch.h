@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "declarations.h"
+#include <framework/graphics/declarations.h>
+#include <framework/graphics/textbatch.h>
+
+// Collects the bars, names and icons of every creature on screen in one pass and hands
+// them to the CREATURE_INFORMATION pool as one coords buffer per color and texture.
+class CreatureInformationBatch
+{
+public:
+    void addBar(const Rect& dest, const Color& color);
+    void addText(CachedText& text, const Rect& dest, const Color& color);
+    void addIcon(const TexturePtr& texture, const Rect& dest, const Rect& src);
+    void addIcon(const TexturePtr& texture, int x, int y);
+
+    // emits everything collected into the current pool and starts over
+    void draw();
+
+private:
+    struct Group
+    {
+        TexturePtr texture;
+        const Texture* key{ nullptr };
+        Color color;
+        CoordsBufferPtr coords;
+    };
+
+    struct LooseIcon
+    {
+        TexturePtr texture;
+        Rect dest;
+        Rect src;
+    };
+
+    static CoordsBuffer& getCoords(std::vector<Group>& groups, const TexturePtr& texture, const Texture* key, const Color& color);
+    static void drawGroups(std::vector<Group>& groups);
+
+    // groups live across frames so their buffers keep the capacity
+    std::vector<Group> m_bars;
+    std::vector<Group> m_icons;
+
+    TextBatch m_texts;
+
+    // icons not placed in the atlas yet, drawn on their own
+    std::vector<LooseIcon> m_looseIcons;
+};
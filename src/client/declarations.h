@@ -58,6 +58,7 @@ class ItemType;
 class TileBlock;
 class AttachedEffect;
 class AttachableObject;
+class CreatureInformationBatch;
 
 #ifdef FRAMEWORK_EDITOR
 class House;
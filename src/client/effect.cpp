@@ -29,10 +29,14 @@
 #include "map.h"
 #include "thingtype.h"
 #include "thingtypemanager.h"
-#include "framework/core/eventdispatcher.h"
 #include "framework/graphics/drawpoolmanager.h"
 #include "framework/graphics/shadermanager.h"
 
+EffectPtr Effect::create()
+{
+    return std::allocate_shared<Effect>(stdext::recycling_allocator<Effect>());
+}
+
 void Effect::draw(const Point& dest, const bool drawThings, LightView* lightView)
 {
     if (!canDraw() || isHided())
@@ -114,7 +118,7 @@ void Effect::onAppear()
     m_animationTimer.restart();
 
     // schedule removal
-    g_dispatcher.scheduleEvent([self = asEffect()] { g_map.removeThing(self); }, m_duration);
+    g_map.scheduleThingRemoval(asEffect(), m_duration);
 }
 
 bool Effect::waitFor(const EffectPtr& effect)
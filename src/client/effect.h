@@ -29,6 +29,8 @@
 class Effect final : public Thing
 {
 public:
+    static EffectPtr create();
+
     void draw(const Point& /*dest*/, bool drawThings = true, LightView* = nullptr) override;
     void setId(uint32_t id) override;
     void setPosition(const Position& position, uint8_t stackPos = 0) override;
@@ -168,9 +168,15 @@ void GameConfig::loadRenderNode(const OTMLNodePtr& mainNode) {
             m_missileTicksPerFrame = node->value<int>();
         else if (node->tag() == "animated-text-duration")
             m_animatedTextDuration = node->value<int>();
+        else if (node->tag() == "animated-text-merge-window")
+            m_animatedTextMergeWindow = node->value<int>();
+        else if (node->tag() == "animated-text-max-count")
+            m_animatedTextMaxCount = node->value<int>();
         else if (node->tag() == "static-duration-per-character")
             m_staticDurationPerCharacter = node->value<int>();
         else if (node->tag() == "min-static-text-duration")
             m_minStatictextDuration = node->value<int>();
+        else if (node->tag() == "outfit-cache-size")
+            m_outfitCacheSize = node->value<int>();
     }
 };
\ No newline at end of file
@@ -61,8 +61,11 @@ public:
     uint16_t getEffectTicksPerFrame() const { return m_effectTicksPerFrame; }
     uint16_t getMissileTicksPerFrame() const { return m_missileTicksPerFrame; }
     uint16_t getAnimatedTextDuration() const { return m_animatedTextDuration; }
+    uint16_t getAnimatedTextMergeWindow() const { return m_animatedTextMergeWindow; }
+    uint16_t getAnimatedTextMaxCount() const { return m_animatedTextMaxCount; }
     uint16_t getStaticDurationPerCharacter() const { return m_staticDurationPerCharacter; }
     uint16_t getMinStatictextDuration() const { return m_minStatictextDuration; }
+    uint16_t getOutfitCacheSize() const { return m_outfitCacheSize; }
 
     double getPlayerDiagonalWalkSpeed() const { return m_playerDiagonalWalkSpeed; }
     double getCreatureDiagonalWalkSpeed() const { return m_creatureDiagonalWalkSpeed; }
@@ -124,8 +127,11 @@ private:
     uint16_t m_effectTicksPerFrame{ 75 };
     uint16_t m_missileTicksPerFrame{ 75 };
     uint16_t m_animatedTextDuration{ 1000 };
+    uint16_t m_animatedTextMergeWindow{ 400 };
+    uint16_t m_animatedTextMaxCount{ 60 };
     uint16_t m_staticDurationPerCharacter{ 60 };
     uint16_t m_minStatictextDuration{ 3000 };
+    uint16_t m_outfitCacheSize{ 0 }; // megabytes of composed outfit frames, 0 disables the cache
 
     std::string m_creatureNameFontName{ "verdana-11px-rounded" };
     std::string m_animatedTextFontName{ "verdana-11px-rounded" };
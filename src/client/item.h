@@ -84,6 +84,7 @@ public:
     void setCount(const int count) { m_countOrSubType = count; updatePatterns(); }
     void setSubType(const int subType) { m_countOrSubType = subType; updatePatterns(); }
     void setColor(const Color& c) { if (m_color != c) m_color = c; }
+    const Color& getColor() const { return m_color; }
     void setPosition(const Position& position, uint8_t stackPos = 0) override;
     void setTooltip(const std::string& str) { m_tooltip = str; }
     void setDurationTime(const uint32_t durationTime) { m_durationTime = durationTime; }
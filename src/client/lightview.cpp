@@ -51,6 +51,14 @@ void LightView::resize(const Size& size, const uint16_t tileSize) {
     for (auto& pixels : m_pixels)
         pixels.resize(size.area() * 4);
 
+    m_lightMap.resize(size.area() * 4);
+    m_dirtyTiles.resize(size.area());
+    for (auto& footprints : m_footprints)
+        footprints.clear();
+    for (auto& segments : m_tileSegments)
+        segments.clear();
+    m_fullUpdate = true;
+
     if (m_texture)
         m_texture->setupSize(m_mapSize);
 }
@@ -93,9 +101,8 @@ void LightView::draw(const Rect& dest, const Rect& src)
 
     m_pool->getHashController().put(src.hash());
     m_pool->getHashController().put(m_globalLightColor.hash());
-    if (m_pool->getHashController().wasModified()) {
-        updatePixels();
-
+    // the upload swaps buffers, so only a frame that rewrote the light map may publish it
+    if (m_pool->getHashController().wasModified() && updatePixels()) {
         SpinLock::Guard guard(m_pool->getThreadLock());
         m_pixels[0].swap(m_pixels[1]);
         updatePixel.store(true, std::memory_order_release);
@@ -135,55 +142,175 @@ void LightView::updateCoords(const Rect& dest, const Rect& src) {
                      static_cast<float>(size.width()) / m_tileSize, static_cast<float>(size.height()) / m_tileSize));
 }
 
-void LightView::updatePixels()
+bool LightView::updatePixels()
 {
-    const auto lightSize = m_lightData.lights.size();
-    const auto mapWidth = m_mapSize.width();
-    const auto mapHeight = m_mapSize.height();
-    const auto tileCenterOffset = m_tileSize / 2;
-    const auto invTileSize = 1.0f / m_tileSize;
+    const auto area = static_cast<size_t>(m_mapSize.area());
+    if (area == 0 || m_lightMap.size() != area * 4)
+        return false;
 
-    auto* pixelData = m_pixels[0].data();
+    updateFootprints();
 
-    for (int y = 0; y < mapHeight; ++y) {
-        for (int x = 0; x < mapWidth; ++x) {
-            const auto centerX = x * m_tileSize + tileCenterOffset;
-            const auto centerY = y * m_tileSize + tileCenterOffset;
-            const auto index = y * mapWidth + x;
+    auto& current = m_footprints[0];
+    auto& previous = m_footprints[1];
+    const auto& tileSegments = m_tileSegments[0];
+    const auto& lastTileSegments = m_tileSegments[1];
+
+    if (m_lastGlobalLightColor != m_globalLightColor || lastTileSegments.size() != area) {
+        m_lastGlobalLightColor = m_globalLightColor;
+        m_fullUpdate = true;
+    }
+
+    m_dirtyArea = {};
+    if (m_fullUpdate) {
+        std::fill(m_dirtyTiles.begin(), m_dirtyTiles.end(), 1);
+        m_dirtyArea = Rect(0, 0, m_mapSize);
+        m_fullUpdate = false;
+    } else {
+        std::fill(m_dirtyTiles.begin(), m_dirtyTiles.end(), 0);
+
+        // tiles whose shade moved to another light segment
+        const auto mapWidth = m_mapSize.width();
+        for (size_t i = 0; i < area; ++i) {
+            if (tileSegments[i] != lastTileSegments[i])
+                markDirty(Rect(static_cast<int>(i % mapWidth), static_cast<int>(i / mapWidth), 1, 1));
+        }
+
+        // lights that were added, removed or changed since the last update
+        m_changedLights.clear();
+        std::set_symmetric_difference(current.begin(), current.end(), previous.begin(), previous.end(), std::back_inserter(m_changedLights));
+        for (const auto& light : m_changedLights)
+            markDirty(getLightArea(light));
+    }
 
-            auto r = m_globalLightColor.r();
-            auto g = m_globalLightColor.g();
-            auto b = m_globalLightColor.b();
+    if (!m_dirtyArea.isValid())
+        return false;
 
-            for (auto i = m_lightData.tiles[index]; i < lightSize; ++i) {
-                const auto& light = m_lightData.lights[i];
+    const auto globalR = m_globalLightColor.r();
+    const auto globalG = m_globalLightColor.g();
+    const auto globalB = m_globalLightColor.b();
 
-                const auto dx = centerX - light.pos.x;
-                const auto dy = centerY - light.pos.y;
-                const auto distanceSq = dx * dx + dy * dy;
+    for (int y = m_dirtyArea.top(); y <= m_dirtyArea.bottom(); ++y) {
+        for (int x = m_dirtyArea.left(); x <= m_dirtyArea.right(); ++x) {
+            const auto index = y * m_mapSize.width() + x;
+            if (!m_dirtyTiles[index]) continue;
 
-                const auto lightRadiusSq = (light.intensity * m_tileSize) * (light.intensity * m_tileSize);
-                if (distanceSq > lightRadiusSq) continue;
+            auto* pixel = &m_lightMap[index * 4];
+            pixel[0] = globalR;
+            pixel[1] = globalG;
+            pixel[2] = globalB;
+            pixel[3] = 255;
+        }
+    }
 
-                const auto distanceNorm = std::sqrt(distanceSq) * invTileSize;
-                float intensity = (-distanceNorm + light.intensity) * 0.2f;
-                if (intensity < 0.01f) continue;
+    for (const auto& light : current)
+        applyLight(light);
 
-                intensity = std::min<float>(intensity, 1.0f);
+    std::memcpy(m_pixels[0].data(), m_lightMap.data(), m_lightMap.size());
+    return true;
+}
 
-                const auto& lightColor = Color::from8bit(light.color) * intensity;
+void LightView::updateFootprints()
+{
+    const auto& tiles = m_lightData.tiles;
+    const auto& lights = m_lightData.lights;
+
+    std::swap(m_footprints[0], m_footprints[1]);
+    std::swap(m_tileSegments[0], m_tileSegments[1]);
+
+    // resetShade stores the light count at the moment the tile was shaded, so the
+    // distinct values split the light list into segments; comparing segment ranks
+    // instead of raw indices keeps tiles stable when unrelated lights come and go.
+    m_segmentBounds.assign(tiles.begin(), tiles.end());
+    std::ranges::sort(m_segmentBounds);
+    m_segmentBounds.erase(std::ranges::unique(m_segmentBounds).begin(), m_segmentBounds.end());
+
+    const auto segmentOf = [this](const size_t value) {
+        return static_cast<uint32_t>(std::ranges::upper_bound(m_segmentBounds, value) - m_segmentBounds.begin());
+    };
+
+    auto& tileSegments = m_tileSegments[0];
+    tileSegments.resize(tiles.size());
+    for (size_t i = 0; i < tiles.size(); ++i)
+        tileSegments[i] = segmentOf(tiles[i]);
+
+    auto& footprints = m_footprints[0];
+    footprints.clear();
+    footprints.reserve(lights.size());
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const auto& light = lights[i];
+        footprints.push_back({ light.pos, light.intensity, light.color, segmentOf(i) });
+    }
 
-                r = std::max<int>(r, lightColor.r());
-                g = std::max<int>(g, lightColor.g());
-                b = std::max<int>(b, lightColor.b());
-            }
+    // sorted so both frames can be diffed in a single pass; the accumulation is a
+    // per-channel max, so the order lights are applied in does not matter.
+    std::sort(footprints.begin(), footprints.end());
+}
 
-            const auto colorIndex = index * 4;
+void LightView::markDirty(const Rect& area)
+{
+    if (!area.isValid())
+        return;
 
-            pixelData[colorIndex] = r;
-            pixelData[colorIndex + 1] = g;
-            pixelData[colorIndex + 2] = b;
-            pixelData[colorIndex + 3] = 255;
+    for (int y = area.top(); y <= area.bottom(); ++y)
+        std::fill_n(m_dirtyTiles.begin() + (y * m_mapSize.width() + area.left()), area.width(), 1);
+
+    m_dirtyArea = m_dirtyArea.isValid() ? m_dirtyArea.united(area) : area;
+}
+
+Rect LightView::getLightArea(const LightFootprint& light) const
+{
+    // tiles whose center lies within the light radius
+    const float radius = light.intensity * m_tileSize;
+    const float half = m_tileSize / 2.f;
+
+    const int left = std::max<int>(0, std::ceil((light.pos.x - radius - half) / m_tileSize));
+    const int top = std::max<int>(0, std::ceil((light.pos.y - radius - half) / m_tileSize));
+    const int right = std::min<int>(m_mapSize.width() - 1, std::floor((light.pos.x + radius - half) / m_tileSize));
+    const int bottom = std::min<int>(m_mapSize.height() - 1, std::floor((light.pos.y + radius - half) / m_tileSize));
+
+    return { Point(left, top), Point(right, bottom) };
+}
+
+void LightView::applyLight(const LightFootprint& light)
+{
+    const auto area = getLightArea(light).intersection(m_dirtyArea);
+    if (!area.isValid())
+        return;
+
+    const auto mapWidth = m_mapSize.width();
+    const auto tileCenterOffset = m_tileSize / 2;
+    const auto invTileSize = 1.0f / m_tileSize;
+    const auto lightRadius = light.intensity * m_tileSize;
+    const auto lightRadiusSq = lightRadius * lightRadius;
+    const auto& tileSegments = m_tileSegments[0];
+
+    const auto& color = Color::from8bit(light.color);
+    const float lightR = color.rF() * 255.f;
+    const float lightG = color.gF() * 255.f;
+    const float lightB = color.bF() * 255.f;
+
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        const auto dy = y * m_tileSize + tileCenterOffset - light.pos.y;
+        const auto dySq = dy * dy;
+
+        for (int x = area.left(); x <= area.right(); ++x) {
+            const auto index = y * mapWidth + x;
+            if (!m_dirtyTiles[index] || tileSegments[index] > light.segment) continue;
+
+            const auto dx = x * m_tileSize + tileCenterOffset - light.pos.x;
+            const auto distanceSq = dx * dx + dySq;
+            if (distanceSq > lightRadiusSq) continue;
+
+            const auto distanceNorm = std::sqrt(static_cast<float>(distanceSq)) * invTileSize;
+            float intensity = (-distanceNorm + light.intensity) * 0.2f;
+            if (intensity < 0.01f) continue;
+
+            intensity = std::min<float>(intensity, 1.0f);
+
+            auto* pixel = &m_lightMap[index * 4];
+            pixel[0] = std::max<uint8_t>(pixel[0], static_cast<uint8_t>(lightR * intensity));
+            pixel[1] = std::max<uint8_t>(pixel[1], static_cast<uint8_t>(lightG * intensity));
+            pixel[2] = std::max<uint8_t>(pixel[2], static_cast<uint8_t>(lightB * intensity));
         }
     }
-}
\ No newline at end of file
+}
@@ -68,8 +68,29 @@ private:
         std::vector<TileLight> lights;
     };
 
+    // Everything that decides what a light contributes to the light map.
+    // segment is the shade group the light belongs to: a tile only receives
+    // lights whose segment is not below its own.
+    struct LightFootprint
+    {
+        Point pos;
+        uint8_t intensity{ 0 };
+        uint8_t color{ 0 };
+        uint32_t segment{ 0 };
+
+        bool operator==(const LightFootprint& o) const { return pos == o.pos && intensity == o.intensity && color == o.color && segment == o.segment; }
+        bool operator<(const LightFootprint& o) const {
+            return std::tie(pos.y, pos.x, intensity, color, segment) < std::tie(o.pos.y, o.pos.x, o.intensity, o.color, o.segment);
+        }
+    };
+
     void updateCoords(const Rect& dest, const Rect& src);
-    void updatePixels();
+    // returns false when nothing changed and m_pixels[0] was left untouched
+    bool updatePixels();
+    void updateFootprints();
+    void markDirty(const Rect& area);
+    void applyLight(const LightFootprint& light);
+    Rect getLightArea(const LightFootprint& light) const;
 
     bool m_isDark{ false };
 
@@ -84,4 +105,17 @@ private:
     TexturePtr m_texture;
     LightData m_lightData;
     std::array<std::vector<uint8_t>, 2> m_pixels;
+
+    // Incremental light map: only tiles covered by lights that appeared,
+    // vanished or changed since the last update (or whose shade changed) are
+    // recomputed; m_lightMap keeps the result between updates.
+    bool m_fullUpdate{ true };
+    Color m_lastGlobalLightColor;
+    Rect m_dirtyArea;
+    std::vector<uint8_t> m_lightMap;
+    std::vector<uint8_t> m_dirtyTiles;
+    std::vector<size_t> m_segmentBounds;
+    std::array<std::vector<uint32_t>, 2> m_tileSegments;
+    std::array<std::vector<LightFootprint>, 2> m_footprints;
+    std::vector<LightFootprint> m_changedLights;
 };
@@ -123,6 +123,10 @@ void Client::registerLuaFunctions()
     g_lua.bindSingletonFunction("g_sprites", "isLoaded", &SpriteManager::isLoaded, &g_sprites);
     g_lua.bindSingletonFunction("g_sprites", "getSprSignature", &SpriteManager::getSignature, &g_sprites);
     g_lua.bindSingletonFunction("g_sprites", "getSpritesCount", &SpriteManager::getSpritesCount, &g_sprites);
+    g_lua.bindSingletonFunction("g_sprites", "setDecodedCacheLimit", &SpriteManager::setDecodedCacheLimit, &g_sprites);
+    g_lua.bindSingletonFunction("g_sprites", "getDecodedCacheLimit", &SpriteManager::getDecodedCacheLimit, &g_sprites);
+    g_lua.bindSingletonFunction("g_sprites", "getDecodedCacheSize", &SpriteManager::getDecodedCacheSize, &g_sprites);
+    g_lua.bindSingletonFunction("g_sprites", "clearDecodedCache", &SpriteManager::clearDecodedCache, &g_sprites);
 
 #ifdef FRAMEWORK_EDITOR
     g_lua.bindSingletonFunction("g_sprites", "saveSpr", &SpriteManager::saveSpr, &g_sprites);
@@ -196,6 +200,7 @@ void Client::registerLuaFunctions()
 
     g_lua.bindSingletonFunction("g_map", "findEveryPath", &Map::findEveryPath, &g_map);
     g_lua.bindSingletonFunction("g_map", "getSpectatorsByPattern", &Map::getSpectatorsByPattern, &g_map);
+    g_lua.bindSingletonFunction("g_map", "getMemoryReport", &Map::getMemoryReport, &g_map);
 
     g_lua.registerSingletonClass("g_minimap");
     g_lua.bindSingletonFunction("g_minimap", "clean", &Minimap::clean, &g_minimap);
@@ -787,11 +792,11 @@ void Client::registerLuaFunctions()
 #endif
 
     g_lua.registerClass<Effect, Thing>();
-    g_lua.bindClassStaticFunction<Effect>("create", [] { return std::make_shared<Effect>(); });
+    g_lua.bindClassStaticFunction<Effect>("create", &Effect::create);
     g_lua.bindClassMemberFunction<Effect>("setId", &Effect::setId);
 
     g_lua.registerClass<Missile, Thing>();
-    g_lua.bindClassStaticFunction<Missile>("create", [] { return std::make_shared<Missile>(); });
+    g_lua.bindClassStaticFunction<Missile>("create", &Missile::create);
     g_lua.bindClassMemberFunction<Missile>("setId", &Missile::setId);
     g_lua.bindClassMemberFunction<Missile>("setPath", &Missile::setPath);
 
@@ -830,7 +835,7 @@ void Client::registerLuaFunctions()
     g_lua.bindClassMemberFunction<AttachedEffect>("move", &AttachedEffect::move);
 
     g_lua.registerClass<StaticText>();
-    g_lua.bindClassStaticFunction<StaticText>("create", [] { return std::make_shared<StaticText>(); });
+    g_lua.bindClassStaticFunction<StaticText>("create", &StaticText::create);
     g_lua.bindClassMemberFunction<StaticText>("addMessage", &StaticText::addMessage);
     g_lua.bindClassMemberFunction<StaticText>("setText", &StaticText::setText);
     g_lua.bindClassMemberFunction<StaticText>("setFont", &StaticText::setFont);
@@ -35,11 +35,14 @@
 #include "tile.h"
 
 #include <framework/core/asyncdispatcher.h>
+#include <framework/core/clock.h>
 #include <framework/core/eventdispatcher.h>
 #include "framework/graphics/drawpoolmanager.h"
 #include "framework/graphics/painter.h"
 #include <framework/ui/uiwidget.h>
 
+#include <bit>
+
 namespace
 {
     void cleanNewSpectators(std::vector<CreaturePtr>& creatures, std::unordered_set<uint32_t>& seenIds, const std::size_t startIndex)
@@ -172,6 +175,8 @@ void Map::cleanDynamicThings()
         floor.tileBlocks.clear();
     }
 
+    m_thingExpirations.clear();
+
     cleanTexts();
 
     g_lua.collectGarbage();
@@ -185,6 +190,10 @@ void Map::addThing(const ThingPtr& thing, const Position& pos, const int16_t sta
     if (thing->isItem() && thing->getId() == 0)
         return;
 
+    // also expire here, so bursts keep the wheel bounded while the map is not being drawn
+    if (thing->isEffect() || thing->isMissile())
+        removeExpiredThings();
+
     if (thing->isMissile()) {
         m_floors[pos.z].missiles.emplace_back(thing->static_self_cast<Missile>());
         thing->setPosition(pos);
@@ -222,6 +231,8 @@ void Map::addAnimatedText(const AnimatedTextPtr& txt, const Position& pos) {
         return;
 
     g_textDispatcher.addEvent([=, this] {
+        removeExpiredAnimatedTexts();
+
         // this code will stack animated texts of the same color
         AnimatedTextPtr prevAnimatedText;
 
@@ -247,6 +258,11 @@ void Map::addAnimatedText(const AnimatedTextPtr& txt, const Position& pos) {
                 offset.y = std::min<int32_t>(offset.y, 12);
                 txt->setOffset(offset);
             }
+
+            // past the cap the oldest text, the one closest to fading out, makes room
+            if (const size_t maxCount = g_gameConfig.getAnimatedTextMaxCount(); maxCount > 0 && m_animatedTexts.size() >= maxCount)
+                m_animatedTexts.erase(m_animatedTexts.begin(), m_animatedTexts.begin() + (m_animatedTexts.size() - maxCount + 1));
+
             m_animatedTexts.emplace_back(txt);
         }
 
@@ -255,6 +271,11 @@ void Map::addAnimatedText(const AnimatedTextPtr& txt, const Position& pos) {
     });
 }
 
+void Map::removeExpiredAnimatedTexts()
+{
+    std::erase_if(m_animatedTexts, [](const AnimatedTextPtr& txt) { return txt->isExpired(); });
+}
+
 ThingPtr Map::getThing(const Position& pos, const int16_t stackPos)
 {
     if (const auto& tile = getTile(pos))
@@ -288,6 +309,16 @@ bool Map::removeThing(const ThingPtr& thing)
     return false;
 }
 
+void Map::scheduleThingRemoval(const ThingPtr& thing, const ticks_t delay)
+{
+    m_thingExpirations.schedule(thing, delay, g_clock.millis());
+}
+
+void Map::removeExpiredThings()
+{
+    m_thingExpirations.tick(g_clock.millis(), [this](const ThingPtr& thing) { removeThing(thing); });
+}
+
 bool Map::removeThingByPos(const Position& pos, const int16_t stackPos)
 {
     if (const auto& tile = getTile(pos))
@@ -696,80 +727,112 @@ bool Map::isLookPossible(const Position& pos)
     return tile && tile->isLookPossible();
 }
 
-bool Map::isCovered(const Position& pos, bool& isLoading, const uint8_t firstFloor)
+bool Map::isCovered(const Position& pos, const uint8_t firstFloor)
 {
     // check for tiles on top of the postion
     Position tilePos = pos;
     while (tilePos.coveredUp() && tilePos.z >= firstFloor) {
         // the below tile is covered when the above tile has a full opaque
-        if (const auto& tile = getTile(tilePos)) {
-            if (tile->isLoading()) {
-                isLoading = true;
-                return false;
-            }
-
-            if (tile->isFullyOpaque())
-                return true;
-        }
+        if (getTileOcclusion(tilePos) & OCCLUSION_OPAQUE)
+            return true;
 
-        if (const auto& tile = getTile(tilePos.translated(1, 1))) {
-            if (tile->hasTopGround())
-                return true;
-        }
+        if (getTileOcclusion(tilePos.translated(1, 1)) & OCCLUSION_TOP_GROUND)
+            return true;
     }
 
     return false;
 }
 
-bool Map::isCompletelyCovered(const Position& pos, bool& isLoading, const uint8_t firstFloor)
+bool Map::isCompletelyCovered(const Position& pos, const uint8_t firstFloor)
 {
     const auto& checkTile = getTile(pos);
+    const bool singleDimension = !checkTile || checkTile->isSingleDimension();
+
     Position tilePos = pos;
     while (tilePos.coveredUp() && tilePos.z >= firstFloor) {
-        bool covered = true;
-        bool done = false;
+        const auto occlusion = getTileOcclusion(tilePos);
 
         // Check is Top Ground
-        for (auto x = -1; ++x < 2 && !done;) {
-            for (auto y = -1; ++y < 2 && !done;) {
-                const auto& tile = getTile(tilePos.translated(x, x));
-                if (!tile || !tile->hasTopGround()) {
-                    covered = false;
-                    done = true;
-                } else if (x == 1 && y == 1 && (!checkTile || checkTile->isSingleDimension())) {
-                    done = true;
-                }
-            }
-        }
+        if (occlusion & getTileOcclusion(tilePos.translated(1, 1)) & OCCLUSION_TOP_GROUND)
+            return true;
 
-        if (covered)
+        // check in 2x2 range tiles that has no transparent pixels
+        if ((occlusion & OCCLUSION_OPAQUE) && (singleDimension ||
+            (getTileOcclusion(tilePos.translated(0, -1)) & getTileOcclusion(tilePos.translated(-1, 0)) & getTileOcclusion(tilePos.translated(-1, -1)) & OCCLUSION_OPAQUE)))
             return true;
+    }
+    return false;
+}
+
+void Map::setTileOcclusion(const Position& pos, const uint8_t occlusion)
+{
+    if (!pos.isMapPosition())
+        return;
 
-        covered = true;
-        done = false;
+    auto& tileBlocks = m_floors[pos.z].tileBlocks;
+    if (const auto it = tileBlocks.find(getBlockIndex(pos)); it != tileBlocks.end())
+        it->second.setOcclusion(pos, occlusion);
+}
 
-        // check in 2x2 range tiles that has no transparent pixels
-        for (auto x = -1; ++x < 2 && !done;) {
-            for (auto y = -1; ++y < 2 && !done;) {
-                const auto& tile = getTile(tilePos.translated(-x, -y));
-                if (tile && tile->isLoading()) {
-                    isLoading = true;
-                    return false;
-                }
+uint8_t Map::getTileOcclusion(const Position& pos)
+{
+    if (!pos.isMapPosition())
+        return 0;
 
-                if (!tile || !tile->isFullyOpaque()) {
-                    covered = false;
-                    done = true;
-                } else if (x == 0 && y == 0 && (!checkTile || checkTile->isSingleDimension())) {
-                    done = true;
+    auto& tileBlocks = m_floors[pos.z].tileBlocks;
+    const auto it = tileBlocks.find(getBlockIndex(pos));
+    if (it == tileBlocks.end())
+        return 0;
+
+    auto& block = it->second;
+    if (block.getOcclusion(pos) & OCCLUSION_PENDING) {
+        if (const auto& tile = block.get(pos))
+            tile->updateOcclusion();
+    }
+
+    return block.getOcclusion(pos);
+}
+
+void Map::getOcclusionRow(const uint8_t z, const int x, const int y, const int count, uint64_t* opaque, uint64_t* topGround)
+{
+    if (y < 0 || y > UINT16_MAX || z > g_gameConfig.getMapMaxZ())
+        return;
+
+    auto& tileBlocks = m_floors[z].tileBlocks;
+
+    // a block row covers up to BLOCK_SIZE columns, copied into the output words at bit i
+    for (int i = std::max<int>(0, -x); i < count && x + i <= UINT16_MAX;) {
+        const Position pos(x + i, y, z);
+        const int column = pos.x % BLOCK_SIZE;
+        const int n = std::min<int>(BLOCK_SIZE - column, count - i);
+
+        if (const auto it = tileBlocks.find(getBlockIndex(pos)); it != tileBlocks.end()) {
+            auto& block = it->second;
+            const uint32_t mask = n == 32 ? UINT32_MAX : ((1u << n) - 1) << column;
+
+            if (uint32_t pending = block.getPendingRow(pos.y) & mask) {
+                for (; pending != 0; pending &= pending - 1) {
+                    if (const auto& tile = block.get(Position(pos.x - column + std::countr_zero(pending), y, z)))
+                        tile->updateOcclusion();
                 }
             }
+
+            const auto copyBits = [&](uint64_t* out, const uint32_t row) {
+                const uint64_t bits = (row & mask) >> column;
+                if (bits == 0) return;
+
+                const int word = i / 64, shift = i % 64;
+                out[word] |= bits << shift;
+                if (shift + n > 64)
+                    out[word + 1] |= bits >> (64 - shift);
+            };
+
+            copyBits(opaque, block.getOpaqueRow(pos.y));
+            copyBits(topGround, block.getTopGroundRow(pos.y));
         }
 
-        if (covered)
-            return true;
+        i += n;
     }
-    return false;
 }
 
 bool Map::isAwareOfPosition(const Position& pos, const AwareRange& awareRange) const
@@ -1164,6 +1227,45 @@ void Map::findPathAsync(const Position& start, const Position& goal, const std::
     });
 }
 
+std::map<std::string, double> Map::getMemoryReport()
+{
+    size_t tiles = 0, spilledTiles = 0, things = 0;
+    size_t bytes = 0, legacyBytes = 0, heapBlocks = 0, legacyHeapBlocks = 0;
+
+    for (auto z = getFirstAwareFloor(); z <= getLastAwareFloor(); ++z) {
+        for (const auto& [key, block] : m_floors[z].tileBlocks) {
+            for (const auto& tile : block.getTiles()) {
+                if (!tile || !isAwareOfPosition(tile->getPosition()))
+                    continue;
+
+                ++tiles;
+                things += tile->getThingCount();
+                if (!tile->getThings().is_inline() || !tile->getWalkingCreatures().is_inline())
+                    ++spilledTiles;
+
+                bytes += tile->getMemoryUsage();
+                legacyBytes += tile->getMemoryUsage(true);
+                heapBlocks += tile->getHeapBlocks();
+                legacyHeapBlocks += tile->getHeapBlocks(true);
+            }
+        }
+    }
+
+    const double count = std::max<size_t>(tiles, 1);
+
+    std::map<std::string, double> report;
+    report["tiles"] = tiles;
+    report["spilledTiles"] = spilledTiles;
+    report["thingsPerTile"] = things / count;
+    report["bytes"] = bytes;
+    report["legacyBytes"] = legacyBytes;
+    report["bytesPerTile"] = bytes / count;
+    report["legacyBytesPerTile"] = legacyBytes / count;
+    report["heapBlocks"] = heapBlocks;
+    report["legacyHeapBlocks"] = legacyHeapBlocks;
+    return report;
+}
+
 int Map::getMinimapColor(const Position& pos)
 {
     int color = 0;
@@ -1535,6 +1637,7 @@ const TilePtr& TileBlock::create(const Position& pos)
 {
     auto& tile = m_tiles[getTileIndex(pos)];
     tile = std::make_shared<Tile>(pos);
+    setOcclusion(pos, 0);
     return tile;
 }
 const TilePtr& TileBlock::getOrCreate(const Position& pos)
@@ -1543,4 +1646,31 @@ const TilePtr& TileBlock::getOrCreate(const Position& pos)
     if (!tile)
         tile = std::make_shared<Tile>(pos);
     return tile;
-}
\ No newline at end of file
+}
+
+void TileBlock::setOcclusion(const Position& pos, const uint8_t occlusion)
+{
+    const uint32_t bit = 1u << (pos.x % BLOCK_SIZE);
+    const auto row = pos.y % BLOCK_SIZE;
+
+    const auto update = [bit](uint32_t& bits, const bool set) {
+        if (set) bits |= bit;
+        else bits &= ~bit;
+    };
+
+    update(m_opaqueRows[row], occlusion & OCCLUSION_OPAQUE);
+    update(m_topGroundRows[row], occlusion & OCCLUSION_TOP_GROUND);
+    update(m_pendingRows[row], occlusion & OCCLUSION_PENDING);
+}
+
+uint8_t TileBlock::getOcclusion(const Position& pos) const
+{
+    const auto column = pos.x % BLOCK_SIZE;
+    const auto row = pos.y % BLOCK_SIZE;
+
+    uint8_t occlusion = 0;
+    if ((m_opaqueRows[row] >> column) & 1) occlusion |= OCCLUSION_OPAQUE;
+    if ((m_topGroundRows[row] >> column) & 1) occlusion |= OCCLUSION_TOP_GROUND;
+    if ((m_pendingRows[row] >> column) & 1) occlusion |= OCCLUSION_PENDING;
+    return occlusion;
+}
@@ -34,14 +34,26 @@ public:
     const TilePtr& create(const Position& pos);
     const TilePtr& getOrCreate(const Position& pos);
     const TilePtr& get(const Position& pos) { return m_tiles[getTileIndex(pos)]; }
-    void remove(const Position& pos) { m_tiles[getTileIndex(pos)] = nullptr; }
+    void remove(const Position& pos) { m_tiles[getTileIndex(pos)] = nullptr; setOcclusion(pos, 0); }
 
     uint32_t getTileIndex(const Position& pos) { return ((pos.y % BLOCK_SIZE) * BLOCK_SIZE) + (pos.x % BLOCK_SIZE); }
 
     const std::array<TilePtr, BLOCK_SIZE* BLOCK_SIZE>& getTiles() const { return m_tiles; }
 
+    void setOcclusion(const Position& pos, uint8_t occlusion);
+    uint8_t getOcclusion(const Position& pos) const;
+
+    uint32_t getOpaqueRow(const uint16_t y) const { return m_opaqueRows[y % BLOCK_SIZE]; }
+    uint32_t getTopGroundRow(const uint16_t y) const { return m_topGroundRows[y % BLOCK_SIZE]; }
+    uint32_t getPendingRow(const uint16_t y) const { return m_pendingRows[y % BLOCK_SIZE]; }
+
 private:
     std::array<TilePtr, BLOCK_SIZE* BLOCK_SIZE> m_tiles;
+
+    // TileOcclusion flags of the tiles, a word per row and a bit per column
+    std::array<uint32_t, BLOCK_SIZE> m_opaqueRows{};
+    std::array<uint32_t, BLOCK_SIZE> m_topGroundRows{};
+    std::array<uint32_t, BLOCK_SIZE> m_pendingRows{};
 };
 
 struct PathFindResult
@@ -129,11 +141,16 @@ public:
     bool removeThing(const ThingPtr& thing);
     bool removeThingByPos(const Position& pos, int16_t stackPos);
 
+    // effects and missiles expire through a shared timer wheel, swept once per frame
+    void scheduleThingRemoval(const ThingPtr& thing, ticks_t delay);
+    void removeExpiredThings();
+
     void addStaticText(const StaticTextPtr& txt, const Position& pos);
     bool removeStaticText(const StaticTextPtr& txt);
 
     void addAnimatedText(const AnimatedTextPtr& txt, const Position& pos);
     bool removeAnimatedText(const AnimatedTextPtr& txt);
+    void removeExpiredAnimatedTexts();
 
     bool isWidgetAttached(const UIWidgetPtr& widget) const;
     void addAttachedWidgetToObject(const UIWidgetPtr& widget, const AttachableObjectPtr& object);
@@ -185,18 +202,14 @@ public:
     void setCentralPosition(const Position& centralPosition);
 
     bool isLookPossible(const Position& pos);
-    bool isCovered(const Position& pos, uint8_t firstFloor = 0) {
-        bool isLoading = false;
-        return isCovered(pos, isLoading, firstFloor);
-    }
-
-    bool isCompletelyCovered(const Position& pos, uint8_t firstFloor = 0) {
-        bool isLoading = false;
-        return isCompletelyCovered(pos, isLoading, firstFloor);
-    }
-
-    bool isCovered(const Position& pos, bool& isLoading, uint8_t firstFloor = 0);
-    bool isCompletelyCovered(const Position& pos, bool& isLoading, uint8_t firstFloor = 0);
+    bool isCovered(const Position& pos, uint8_t firstFloor = 0);
+    bool isCompletelyCovered(const Position& pos, uint8_t firstFloor = 0);
+
+    // occlusion bits are updated by the tiles whenever their things change,
+    // pending tiles are re-evaluated when read until their opacity is known
+    void setTileOcclusion(const Position& pos, uint8_t occlusion);
+    uint8_t getTileOcclusion(const Position& pos);
+    void getOcclusionRow(uint8_t z, int x, int y, int count, uint64_t* opaque, uint64_t* topGround);
     bool isAwareOfPosition(const Position& pos) const { return isAwareOfPosition(pos, m_awareRange); }
     bool isAwareOfPosition(const Position& pos, const AwareRange& awareRange) const;
 
@@ -212,8 +225,8 @@ public:
     uint8_t getLastAwareFloor() const;
     const std::vector<MissilePtr>& getFloorMissiles(const uint8_t z) { return m_floors[z].missiles; }
 
-    std::vector<AnimatedTextPtr> getAnimatedTexts() { return m_animatedTexts; }
-    std::vector<StaticTextPtr> getStaticTexts() { return m_staticTexts; }
+    const std::vector<AnimatedTextPtr>& getAnimatedTexts() const { return m_animatedTexts; }
+    const std::vector<StaticTextPtr>& getStaticTexts() const { return m_staticTexts; }
 
     std::tuple<std::vector<Otc::Direction>, Otc::PathFindResult> findPath(const Position& start, const Position& goal,
                                                                           int maxComplexity, int flags = 0);
@@ -227,6 +240,9 @@ public:
     std::map<std::string, std::tuple<int, int, int, std::string>> findEveryPath(const Position& start, int maxDistance, const std::map<std::string, std::string>& params);
     std::vector<CreaturePtr> getSpectatorsByPattern(const Position& centerPos, const std::string& pattern, Otc::Direction direction);
 
+    // tile memory over the aware range, next to an estimate of the same tiles with std::vector thing lists
+    std::map<std::string, double> getMemoryReport();
+
     int getMinimapColor(const Position& pos);
     bool isSightClear(const Position& fromPos, const Position& toPos);
 
@@ -253,6 +269,8 @@ private:
 
     std::unordered_map<UIWidgetPtr, AttachableObjectPtr> m_attachedObjectWidgetMap;
 
+    stdext::timer_wheel<ThingPtr> m_thingExpirations;
+
 #ifdef FRAMEWORK_EDITOR
     std::unordered_map<Position, std::string, Position::Hasher> m_waypoints;
     std::unordered_map<uint32_t, Color> m_zoneColors;
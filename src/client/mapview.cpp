@@ -40,6 +40,24 @@
 #include "framework/graphics/texturemanager.h"
 #include <framework/platform/platformwindow.h>
 
+namespace
+{
+    // the cells walked by the diagonals of a rebuild, which also cover the row below the view
+    bool isDrawCell(const Size& dimension, const int ix, const int iy)
+    {
+        if (ix < 0 || iy < 0) return false;
+        return iy < dimension.height() ? ix < dimension.width() : iy == dimension.height() && ix < dimension.width() - 1;
+    }
+
+    // diagonals from the top left corner, each one from the bottom to the top
+    bool isBeforeInDrawOrder(const Point& a, const Point& b)
+    {
+        if (a.x + a.y != b.x + b.y)
+            return a.x + a.y < b.x + b.y;
+        return a.y > b.y;
+    }
+}
+
 MapView::MapView() : m_lightView(std::make_unique<LightView>(Size())), m_pool(g_drawPool.get(DrawPoolType::MAP))
 {
     m_floors.resize(g_gameConfig.getMapMaxZ() + 1);
@@ -232,8 +250,10 @@ void MapView::drawCreatureInformation() {
 
         creature->setCovered(isCovered);
 
-        creature->drawInformation(m_posInfo, transformPositionTo2D(creature->getPosition()), flags);
+        creature->drawInformation(m_posInfo, transformPositionTo2D(creature->getPosition()), flags, m_creatureInformationBatch);
     }
+
+    m_creatureInformationBatch.draw();
 }
 
 void MapView::drawForeground(const Rect& rect)
@@ -251,8 +271,9 @@ void MapView::drawForeground(const Rect& rect)
         p.x *= m_posInfo.horizontalStretchFactor;
         p.y *= m_posInfo.verticalStretchFactor;
         p += rect.topLeft();
-        staticText->drawText(p.scale(g_app.getStaticTextScale()), rect);
+        staticText->drawText(p.scale(g_app.getStaticTextScale()), rect, m_staticTextBatch);
     }
+    m_staticTextBatch.draw();
 
     g_drawPool.scale(g_app.getAnimatedTextScale());
     for (const auto& animatedText : g_map.getAnimatedTexts()) {
@@ -265,8 +286,9 @@ void MapView::drawForeground(const Rect& rect)
         p.x *= m_posInfo.horizontalStretchFactor;
         p.y *= m_posInfo.verticalStretchFactor;
         p += rect.topLeft();
-        animatedText->drawText(p, rect);
+        animatedText->drawText(p, rect, m_animatedTextBatch);
     }
+    m_animatedTextBatch.draw();
 
     g_drawPool.scale(1.f);
     for (const auto& tile : m_foregroundTiles) {
@@ -288,14 +310,14 @@ void MapView::updateVisibleTiles()
     if (!m_posInfo.camera.isValid())
         return;
 
-    // clear current visible tiles cache
-    do {
-        m_floors[m_floorMin].cachedVisibleTiles.clear();
-    } while (++m_floorMin <= m_floorMax);
+    // the floor bounds are recalculated while caching, the tiles are kept until it is
+    // known whether the cache can be shifted or has to be rebuilt
+    m_floorMin = m_floorMax + 1;
 
     m_lockedFirstVisibleFloor = m_floorViewMode == Otc::LOCKED ? m_posInfo.camera.z : -1;
 
     const auto prevFirstVisibleFloor = m_cachedFirstVisibleFloor;
+    const auto lastCameraPosition = m_lastCameraPosition;
 
     if (m_lastCameraPosition != m_posInfo.camera) {
         if (m_lastCameraPosition.z != m_posInfo.camera.z) {
@@ -338,14 +360,160 @@ void MapView::updateVisibleTiles()
     m_lastCameraPosition = m_posInfo.camera;
     destroyHighlightTile();
 
-    const bool checkIsCovered = !m_drawCoveredThings && getFadeLevel(m_cachedFirstVisibleFloor) == 1.f;
+    const VisibleTilesState state{
+        .firstFloor = cachedFirstVisibleFloor,
+        .lastFloor = m_cachedLastVisibleFloor,
+        .coveredFloor = m_cachedFirstVisibleFloor,
+        .checkIsCovered = !m_drawCoveredThings && getFadeLevel(m_cachedFirstVisibleFloor) == 1.f,
+        .drawingLights = isDrawingLights()
+    };
+
+    // walking a single step only changes the border of the view, so the cached tiles are
+    // shifted instead of looking up every tile again, and tiles updated in place only refresh
+    // their own cell; anything else rebuilds the cache
+    const bool canReuse = !m_rebuildVisibleTiles && state == m_visibleTilesState;
+    const bool cameraMoved = lastCameraPosition != m_posInfo.camera;
+    m_visibleTilesState = state;
+
+    if (!canReuse || (cameraMoved && !shiftVisibleTiles(lastCameraPosition)) || !refreshVisibleTiles())
+        rebuildVisibleTiles();
+
+    m_refreshTilePositions.clear();
+    m_updateVisibleTiles = false;
+    m_rebuildVisibleTiles = false;
+    updateHighlightTile(m_mousePosition);
+}
+
+bool MapView::canAddVisibleTile(const TilePtr& tile, const Position& tilePos, const Point& cell)
+{
+    if (m_visibleTilesState.checkIsCovered && isTileCompletelyCovered(tile, cell)) {
+        if (m_floorViewMode != Otc::ALWAYS_WITH_TRANSPARENCY || (tilePos.z < m_posInfo.camera.z && isTileCovered(tile, cell))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MapView::isTileCovered(const TilePtr& tile, const Point& cell) const
+{
+    if (!m_occlusionValid)
+        return tile->isCovered(m_cachedFirstVisibleFloor);
+
+    return isCellOccluded(m_occlusion[tile->getPosition().z].covered, cell);
+}
+
+bool MapView::isTileCompletelyCovered(const TilePtr& tile, const Point& cell) const
+{
+    if (!m_occlusionValid)
+        return tile->isCompletelyCovered(m_cachedFirstVisibleFloor);
+
+    if (tile->hasCreatures() || !tile->getWalkingCreatures().empty() || tile->hasLight())
+        return false;
+
+    const auto& occlusion = m_occlusion[tile->getPosition().z];
+    return isCellOccluded(tile->isSingleDimension() ? occlusion.completelyCoveredSingle : occlusion.completelyCovered, cell);
+}
+
+bool MapView::isViewInsideMap() const
+{
+    // the tile of a view cell moves one column and row per floor it is covered up, cells
+    // only map to tiles while none of those positions is clamped at the map borders
+    const auto& camera = m_posInfo.camera;
+    const int originX = camera.x - m_virtualCenterOffset.x;
+    const int originY = camera.y - m_virtualCenterOffset.y;
+    const int minCover = camera.z - m_visibleTilesState.lastFloor;
+    const int maxCover = camera.z - std::min(m_visibleTilesState.firstFloor, m_visibleTilesState.coveredFloor);
+
+    return std::min(originX, originY) + minCover > 0
+        && std::max(originX + m_drawDimension.width(), originY + m_drawDimension.height() + 1) + maxCover < UINT16_MAX;
+}
+
+void MapView::updateOcclusion()
+{
+    m_occlusionValid = m_visibleTilesState.checkIsCovered && isViewInsideMap();
+    if (!m_occlusionValid)
+        return;
+
+    // the tile above a cell is the same cell one floor up, so the coverage of every cell is the
+    // union of the floors above it; the grid has a border of one cell for the neighbour checks
+    // and covers the extra row walked below the view
+    const auto& camera = m_posInfo.camera;
+    const int columns = m_drawDimension.width() + 2;
+    const int rows = m_drawDimension.height() + 3;
+    const int stride = (columns + 63) / 64;
+    const size_t gridSize = static_cast<size_t>(stride) * rows;
+
+    m_occlusionStride = stride;
+    m_occlusion.resize(m_floors.size());
+    m_occlusionOpaque.resize(gridSize);
+    m_occlusionTopGround.resize(gridSize);
+
+    // bit j of the word w, taken from the column to the right (shiftRight) or to the left (shiftLeft)
+    const auto shiftRight = [stride](const uint64_t* row, const int w) { return (row[w] >> 1) | (w + 1 < stride ? row[w + 1] << 63 : 0); };
+    const auto shiftLeft = [](const uint64_t* row, const int w) { return (row[w] << 1) | (w > 0 ? row[w - 1] >> 63 : 0); };
+
+    const auto coveredFloor = m_visibleTilesState.coveredFloor;
+    const auto firstFloor = std::min(m_visibleTilesState.firstFloor, coveredFloor);
+    const auto lastFloor = m_visibleTilesState.lastFloor;
+
+    // nothing above the first visible floor covers anything
+    for (int iz = firstFloor; iz <= coveredFloor; ++iz) {
+        auto& floor = m_occlusion[iz];
+        floor.covered.assign(gridSize, 0);
+        floor.completelyCovered.assign(gridSize, 0);
+        floor.completelyCoveredSingle.assign(gridSize, 0);
+    }
+
+    for (int iz = coveredFloor; iz < lastFloor; ++iz) {
+        auto& below = m_occlusion[iz + 1];
+        below = m_occlusion[iz];
+
+        // occluders of this floor, merged into the coverage of the floor below
+        std::ranges::fill(m_occlusionOpaque, 0);
+        std::ranges::fill(m_occlusionTopGround, 0);
+
+        const int cover = camera.z - iz;
+        const int x = camera.x - m_virtualCenterOffset.x + cover - 1;
+        const int y = camera.y - m_virtualCenterOffset.y + cover - 1;
+        for (int r = 0; r < rows; ++r)
+            g_map.getOcclusionRow(iz, x, y + r, columns, &m_occlusionOpaque[r * stride], &m_occlusionTopGround[r * stride]);
+
+        for (int r = 1; r < rows - 1; ++r) {
+            const uint64_t* opaque = &m_occlusionOpaque[r * stride];
+            const uint64_t* opaqueUp = opaque - stride;
+            const uint64_t* topGround = &m_occlusionTopGround[r * stride];
+            const uint64_t* topGroundDown = topGround + stride;
+
+            for (int w = 0; w < stride; ++w) {
+                const auto i = r * stride + w;
+                const uint64_t topGroundBelow = shiftRight(topGroundDown, w);
+                const uint64_t topGroundCovered = topGround[w] & topGroundBelow;
+
+                below.covered[i] |= opaque[w] | topGroundBelow;
+                below.completelyCoveredSingle[i] |= topGroundCovered | opaque[w];
+                below.completelyCovered[i] |= topGroundCovered | (opaque[w] & opaqueUp[w] & shiftLeft(opaque, w) & shiftLeft(opaqueUp, w));
+            }
+        }
+    }
+}
+
+void MapView::rebuildVisibleTiles()
+{
+    // clear current visible tiles cache
+    for (auto& floor : m_floors)
+        floor.cachedVisibleTiles.clear();
+
+    updateOcclusion();
+
+    const auto firstFloor = m_visibleTilesState.firstFloor;
 
     // cache visible tiles in draw order
     // draw from last floor (the lower) to first floor (the higher)
     const uint32_t numDiagonals = m_drawDimension.width() + m_drawDimension.height() - 1;
 
     auto processDiagonalRange = [&](std::vector<FloorData>& floors, uint32_t start, uint32_t end) {
-        for (int_fast32_t iz = m_cachedLastVisibleFloor; iz >= cachedFirstVisibleFloor; --iz) {
+        for (int_fast32_t iz = m_cachedLastVisibleFloor; iz >= firstFloor; --iz) {
             auto& floor = floors[iz].cachedVisibleTiles;
 
             for (uint_fast32_t diagonal = start; diagonal < end; ++diagonal) {
@@ -357,20 +525,13 @@ void MapView::updateVisibleTiles()
                     if (const auto& tile = g_map.getTile(tilePos)) {
                         if (!tile->isDrawable()) continue;
 
-                        bool addTile = true;
-
-                        if (checkIsCovered && tile->isCompletelyCovered(m_cachedFirstVisibleFloor, m_resetCoveredCache)) {
-                            if (m_floorViewMode != Otc::ALWAYS_WITH_TRANSPARENCY || (tilePos.z < m_posInfo.camera.z && tile->isCovered(m_cachedFirstVisibleFloor))) {
-                                addTile = false;
-                            }
-                        }
-
+                        const bool addTile = canAddVisibleTile(tile, tilePos, { ix, iy });
                         if (addTile) {
                             floor.tiles.emplace_back(tile);
                             tile->onAddInMapView();
                         }
 
-                        if (isDrawingLights() && tile->canShade()) {
+                        if (m_visibleTilesState.drawingLights && tile->canShade()) {
                             floor.shades.emplace_back(tile);
                         }
 
@@ -386,7 +547,8 @@ void MapView::updateVisibleTiles()
         }
     };
 
-    if (m_multithreading) {
+    // the map fallback of the coverage checks refreshes pending occlusion bits, which is not thread safe
+    if (m_multithreading && (m_occlusionValid || !m_visibleTilesState.checkIsCovered)) {
         static const int numThreads = g_asyncDispatcher.get_thread_count();
         static BS::multi_future<void> tasks(numThreads);
         tasks.clear();
@@ -420,16 +582,176 @@ void MapView::updateVisibleTiles()
     } else {
         processDiagonalRange(m_floors, 0, numDiagonals);
     }
+}
 
-    m_updateVisibleTiles = false;
-    m_resetCoveredCache = false;
-    updateHighlightTile(m_mousePosition);
+bool MapView::shiftVisibleTiles(const Position& lastCameraPosition)
+{
+    const auto& camera = m_posInfo.camera;
+    const int dx = camera.x - lastCameraPosition.x;
+    const int dy = camera.y - lastCameraPosition.y;
+    if (camera.z != lastCameraPosition.z || std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0))
+        return false;
+
+    const auto& dimension = m_drawDimension;
+    const auto firstFloor = m_visibleTilesState.firstFloor;
+    const auto lastFloor = m_visibleTilesState.lastFloor;
+
+    if (!isViewInsideMap())
+        return false;
+
+    updateOcclusion();
+
+    // the cell (0, 0) of a floor is the top left tile of the view covered up to that floor
+    const int originX = camera.x - m_virtualCenterOffset.x;
+    const int originY = camera.y - m_virtualCenterOffset.y;
+
+    // cells that came into the view with this step
+    std::vector<Point> enteringCells;
+    for (int iy = 0; iy <= dimension.height(); ++iy) {
+        for (int ix = 0; ix < dimension.width(); ++ix) {
+            if (isDrawCell(dimension, ix, iy) && !isDrawCell(dimension, ix + dx, iy + dy))
+                enteringCells.emplace_back(ix, iy);
+        }
+    }
+    std::ranges::sort(enteringCells, isBeforeInDrawOrder);
+
+    std::vector<TilePtr> enteringTiles;
+    std::vector<TilePtr> enteringShades;
+
+    for (int iz = lastFloor; iz >= firstFloor; --iz) {
+        auto& floor = m_floors[iz].cachedVisibleTiles;
+
+        const int cover = camera.z - iz;
+        const auto cellOf = [&](const TilePtr& tile) {
+            const auto& pos = tile->getPosition();
+            return Point(pos.x - originX - cover, pos.y - originY - cover);
+        };
+        const auto isOutOfView = [&](const TilePtr& tile) {
+            const auto& cell = cellOf(tile);
+            return !isDrawCell(dimension, cell.x, cell.y);
+        };
+        // every cell moved by the same offset, so the remaining tiles are still in draw order
+        const auto mergeEntering = [&](std::vector<TilePtr>& tiles, std::vector<TilePtr>& entering) {
+            if (entering.empty()) return;
+
+            const auto size = tiles.size();
+            tiles.insert(tiles.end(), std::make_move_iterator(entering.begin()), std::make_move_iterator(entering.end()));
+            std::inplace_merge(tiles.begin(), tiles.begin() + size, tiles.end(), [&](const TilePtr& a, const TilePtr& b) {
+                return isBeforeInDrawOrder(cellOf(a), cellOf(b));
+            });
+            entering.clear();
+        };
+
+        std::erase_if(floor.tiles, isOutOfView);
+        std::erase_if(floor.shades, isOutOfView);
+
+        for (const auto& cell : enteringCells) {
+            auto tilePos = camera.translated(cell.x - m_virtualCenterOffset.x, cell.y - m_virtualCenterOffset.y);
+            tilePos.coveredUp(cover);
+
+            const auto& tile = g_map.getTile(tilePos);
+            if (!tile || !tile->isDrawable()) continue;
+
+            if (canAddVisibleTile(tile, tilePos, cell))
+                enteringTiles.emplace_back(tile);
+
+            if (m_visibleTilesState.drawingLights && tile->canShade())
+                enteringShades.emplace_back(tile);
+        }
+
+        mergeEntering(floor.tiles, enteringTiles);
+        mergeEntering(floor.shades, enteringShades);
+
+        if (!floor.tiles.empty() || !floor.shades.empty()) {
+            if (iz < m_floorMin)
+                m_floorMin = iz;
+            else if (iz > m_floorMax)
+                m_floorMax = iz;
+        }
+    }
+
+    // replayed in draw order, as a rebuild does, so lying corpses flag their neighbours after those were reset
+    for (int iz = lastFloor; iz >= firstFloor; --iz) {
+        for (const auto& tile : m_floors[iz].cachedVisibleTiles.tiles)
+            tile->onAddInMapView();
+    }
+
+    return true;
+}
+
+bool MapView::refreshVisibleTiles()
+{
+    if (!isViewInsideMap())
+        return false;
+
+    const auto& camera = m_posInfo.camera;
+    const auto firstFloor = m_visibleTilesState.firstFloor;
+    const auto lastFloor = m_visibleTilesState.lastFloor;
+    const int originX = camera.x - m_virtualCenterOffset.x;
+    const int originY = camera.y - m_virtualCenterOffset.y;
+
+    bool refreshed = false;
+    for (const auto& pos : m_refreshTilePositions) {
+        if (pos.z < firstFloor || pos.z > lastFloor)
+            continue;
+
+        const int cover = camera.z - pos.z;
+        const Point cell(pos.x - originX - cover, pos.y - originY - cover);
+        if (!isDrawCell(m_drawDimension, cell.x, cell.y))
+            continue;
+
+        auto& floor = m_floors[pos.z].cachedVisibleTiles;
+        const auto isAtPos = [&pos](const TilePtr& tile) { return tile->getPosition() == pos; };
+        std::erase_if(floor.tiles, isAtPos);
+        std::erase_if(floor.shades, isAtPos);
+
+        const auto& tile = g_map.getTile(pos);
+        if (!tile || !tile->isDrawable())
+            continue;
+
+        // the other tiles of the floor keep their cells, so the tile goes back to its place in draw order
+        const auto insertInDrawOrder = [&](std::vector<TilePtr>& tiles) {
+            const auto it = std::upper_bound(tiles.begin(), tiles.end(), cell, [&](const Point& a, const TilePtr& b) {
+                const auto& bPos = b->getPosition();
+                return isBeforeInDrawOrder(a, { bPos.x - originX - cover, bPos.y - originY - cover });
+            });
+            tiles.insert(it, tile);
+        };
+
+        if (canAddVisibleTile(tile, pos, cell))
+            insertInDrawOrder(floor.tiles);
+
+        if (m_visibleTilesState.drawingLights && tile->canShade())
+            insertInDrawOrder(floor.shades);
+
+        refreshed = true;
+    }
+
+    for (int iz = lastFloor; iz >= firstFloor; --iz) {
+        const auto& floor = m_floors[iz].cachedVisibleTiles;
+        if (floor.tiles.empty() && floor.shades.empty())
+            continue;
+
+        if (iz < m_floorMin)
+            m_floorMin = iz;
+        else if (iz > m_floorMax)
+            m_floorMax = iz;
+
+        // replayed in draw order, as a rebuild does, so lying corpses flag their neighbours after those were reset
+        if (refreshed) {
+            for (const auto& tile : floor.tiles)
+                tile->onAddInMapView();
+        }
+    }
+
+    return true;
 }
 
 void MapView::updateRect(const Rect& rect) {
     if (m_posInfo.camera != getCameraPosition()) {
         m_posInfo.camera = getCameraPosition();
-        requestUpdateVisibleTiles();
+        // single steps shift the cache, updateVisibleTiles falls back to a rebuild for anything else
+        m_updateVisibleTiles = true;
         requestUpdateMapPosInfo();
     }
 
@@ -542,14 +864,15 @@ void MapView::updateLight()
 
 void MapView::onTileUpdate(const Position& pos, const ThingPtr& thing, const Otc::Operation op)
 {
+    // the map occlusion bits are already up to date, but tiles culled as covered have to come back
     if (thing && thing->isOpaque() && op == Otc::OPERATION_REMOVE)
-        m_resetCoveredCache = true;
+        requestUpdateVisibleTiles();
 
     if (op == Otc::OPERATION_CLEAN) {
         if (m_lastHighlightTile && m_lastHighlightTile->getPosition() == pos)
             m_lastHighlightTile = nullptr;
 
-        requestUpdateVisibleTiles();
+        requestRefreshVisibleTile(pos);
     }
 }
 
@@ -577,9 +900,14 @@ void MapView::onKeyRelease(const InputEvent& inputEvent)
     }
 }
 
-void MapView::onMapCenterChange(const Position& /*newPos*/, const Position& /*oldPos*/)
+void MapView::onMapCenterChange(const Position& newPos, const Position& oldPos)
 {
-    requestUpdateVisibleTiles();
+    // a single step is shifted, the cells it leaves in place are refreshed through their tile updates
+    const bool isStep = newPos.z == oldPos.z && newPos != oldPos && std::abs(newPos.x - oldPos.x) <= 1 && std::abs(newPos.y - oldPos.y) <= 1;
+    if (isStep)
+        m_updateVisibleTiles = true;
+    else
+        requestUpdateVisibleTiles();
 }
 
 void MapView::lockFirstVisibleFloor(const uint8_t firstVisibleFloor)
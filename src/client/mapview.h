@@ -21,8 +21,10 @@
  */
 
 #pragma once
+#include "creatureinformationbatch.h"
 #include "declarations.h"
 #include <framework/graphics/declarations.h>
+#include <framework/graphics/textbatch.h>
 #include <framework/luaengine/luaobject.h>
 
 #include "framework/core/timer.h"
@@ -165,6 +167,27 @@ private:
         Timer fadingTimers;
     };
 
+    // parameters the visible tiles cache was built with, a single step camera move
+    // can only shift the cache while all of them stay the same
+    struct VisibleTilesState
+    {
+        uint8_t firstFloor{ 0 };
+        uint8_t lastFloor{ 0 };
+        uint8_t coveredFloor{ 0 };
+        bool checkIsCovered{ false };
+        bool drawingLights{ false };
+
+        bool operator==(const VisibleTilesState&) const = default;
+    };
+
+    // view cells covered by the floors above, a bit per cell and (width + 2) bits per row
+    struct FloorOcclusion
+    {
+        std::vector<uint64_t> covered;
+        std::vector<uint64_t> completelyCovered;
+        std::vector<uint64_t> completelyCoveredSingle; // single dimension tiles only need the tile above
+    };
+
     struct Crosshair
     {
         bool positionChanged = false;
@@ -179,9 +202,28 @@ private:
     void updateViewportDirectionCache();
     void updateGeometry(const Size& visibleDimension);
     void updateVisibleTiles();
+    void rebuildVisibleTiles();
+    bool shiftVisibleTiles(const Position& lastCameraPosition);
+    bool refreshVisibleTiles();
+    bool canAddVisibleTile(const TilePtr& tile, const Position& tilePos, const Point& cell);
+    bool isTileCovered(const TilePtr& tile, const Point& cell) const;
+    bool isTileCompletelyCovered(const TilePtr& tile, const Point& cell) const;
+    bool isViewInsideMap() const;
+    void updateOcclusion();
+
+    bool isCellOccluded(const std::vector<uint64_t>& mask, const Point& cell) const
+    {
+        const int column = cell.x + 1;
+        return (mask[(cell.y + 1) * m_occlusionStride + column / 64] >> (column % 64)) & 1;
+    }
     void updateRect(const Rect& rect);
     void updateViewport(const Otc::Direction dir = Otc::InvalidDirection) { m_viewport = m_viewPortDirection[dir]; }
-    void requestUpdateVisibleTiles() { m_updateVisibleTiles = true; }
+    void requestUpdateVisibleTiles() { m_updateVisibleTiles = m_rebuildVisibleTiles = true; }
+    void requestRefreshVisibleTile(const Position& pos)
+    {
+        m_refreshTilePositions.emplace_back(pos);
+        m_updateVisibleTiles = true;
+    }
     void requestUpdateMapPosInfo() { m_updateMapPosInfo = true; }
 
     void registerEvents();
@@ -250,8 +292,9 @@ private:
 
     bool m_limitVisibleDimension{ true };
     bool m_updateVisibleTiles{ true };
+    bool m_rebuildVisibleTiles{ true };
     bool m_updateMapPosInfo{ true };
-    bool m_resetCoveredCache{ true };
+    bool m_occlusionValid{ false };
     bool m_shaderSwitchDone{ true };
     bool m_drawHealthBars{ true };
     bool m_drawManaBar{ true };
@@ -278,10 +321,23 @@ private:
 
     std::vector<TilePtr> m_foregroundTiles;
 
+    VisibleTilesState m_visibleTilesState;
+
+    std::vector<FloorOcclusion> m_occlusion;
+    std::vector<uint64_t> m_occlusionOpaque;
+    std::vector<uint64_t> m_occlusionTopGround;
+    uint16_t m_occlusionStride{ 0 };
+
+    // tiles updated in place since the last update, refreshed in their own cell
+    std::vector<Position> m_refreshTilePositions;
+
     PainterShaderProgramPtr m_shader;
     PainterShaderProgramPtr m_nextShader;
     LightViewPtr m_lightView;
     CreaturePtr m_followingCreature;
+    CreatureInformationBatch m_creatureInformationBatch;
+    TextBatch m_staticTextBatch;
+    TextBatch m_animatedTextBatch;
 
     MapPosInfo m_posInfo;
     Otc::FloorViewMode m_floorViewMode{ Otc::NORMAL };
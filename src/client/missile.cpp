@@ -27,10 +27,14 @@
 #include "map.h"
 #include "thingtype.h"
 #include "thingtypemanager.h"
-#include "framework/core/eventdispatcher.h"
 #include "framework/graphics/drawpoolmanager.h"
 #include "framework/graphics/shadermanager.h"
 
+MissilePtr Missile::create()
+{
+    return std::allocate_shared<Missile>(stdext::recycling_allocator<Missile>());
+}
+
 void Missile::draw(const Point& dest, const bool drawThings, LightView* lightView)
 {
     if (!canDraw() || isHided())
@@ -58,9 +62,7 @@ void Missile::setPath(const Position& fromPosition, const Position& toPosition)
 
     const float deltaLength = m_delta.length();
     if (deltaLength == 0) {
-        g_dispatcher.addEvent([self = asMissile()] {
-            g_map.removeThing(self);
-        });
+        m_duration = 0;
         return;
     }
 
@@ -70,9 +72,12 @@ void Missile::setPath(const Position& fromPosition, const Position& toPosition)
     m_delta *= g_gameConfig.getSpriteSize();
     m_animationTimer.restart();
     m_distance = fromPosition.distance(toPosition);
+}
 
-    // schedule removal
-    g_dispatcher.scheduleEvent([self = asMissile()] { g_map.removeThing(self); }, m_duration);
+void Missile::onAppear()
+{
+    // scheduled once the missile is on the map, an expiry swept before that would find nothing to remove
+    g_map.scheduleThingRemoval(asMissile(), m_duration);
 }
 
 void Missile::setDirection(const Otc::Direction dir) {
@@ -29,7 +29,10 @@
 class Missile final : public Thing
 {
 public:
+    static MissilePtr create();
+
     void draw(const Point& dest, bool drawThings = true, LightView* lightView = nullptr) override;
+    void onAppear() override;
 
     void setId(uint32_t id) override;
     void setPath(const Position& fromPosition, const Position& toPosition);
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "outfitcache.h"
+
+#include "gameconfig.h"
+#include "outfit.h"
+#include "thingtype.h"
+#include "thingtypemanager.h"
+#include "framework/core/asyncdispatcher.h"
+#include "framework/core/clock.h"
+#include "framework/graphics/image.h"
+#include "framework/graphics/texture.h"
+
+OutfitCache g_outfitCache;
+
+namespace
+{
+    // a frame that could not be composed (sprites still loading) is retried after this long
+    constexpr ticks_t RETRY_DELAY = 1000;
+}
+
+TexturePtr OutfitCache::getFrame(ThingType* type, const Outfit& outfit, const int xPattern, const int zPattern, const int animationPhase)
+{
+    const size_t budget = static_cast<size_t>(g_gameConfig.getOutfitCacheSize()) * 1024 * 1024;
+    if (budget == 0) {
+        // turned off at runtime, let go of what was kept
+        std::scoped_lock l(m_mutex);
+        if (!m_entries.empty())
+            reset();
+        return nullptr;
+    }
+
+    if (!type || xPattern < 0 || xPattern > 3 || zPattern < 0 || zPattern > 3 || animationPhase < 0 || animationPhase > 0xFF)
+        return nullptr;
+
+    // looktype, head, body, legs, feet, addons, direction, mounted and animation phase
+    const uint64_t key = static_cast<uint64_t>(outfit.getId()) << 48
+        | static_cast<uint64_t>(outfit.getHead()) << 40
+        | static_cast<uint64_t>(outfit.getBody()) << 32
+        | static_cast<uint64_t>(outfit.getLegs()) << 24
+        | static_cast<uint64_t>(outfit.getFeet()) << 16
+        | static_cast<uint64_t>(outfit.getAddons() & 0xF) << 12
+        | static_cast<uint64_t>(xPattern) << 10
+        | static_cast<uint64_t>(zPattern) << 8
+        | static_cast<uint64_t>(animationPhase);
+
+    std::scoped_lock l(m_mutex);
+
+    const auto& [it, inserted] = m_entries.try_emplace(key);
+    auto& entry = it->second;
+
+    if (entry.texture) {
+        ++m_hits;
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+        if (m_bytes > budget)
+            evict(budget);
+        return entry.texture;
+    }
+
+    if (entry.pending || (!inserted && g_clock.millis() - entry.failedAt < RETRY_DELAY))
+        return nullptr;
+
+    ++m_misses;
+    entry.pending = true;
+
+    const std::array colors = { outfit.getHeadColor(), outfit.getBodyColor(), outfit.getLegsColor(), outfit.getFeetColor() };
+    g_asyncDispatcher.detach_task([this, id = type->getId(), category = type->getCategory(), key, colors, xPattern, zPattern, animationPhase, addons = outfit.getAddons(), generation = m_generation] {
+        // the types are reloaded only after clear() bumped the generation, so while it still
+        // matches the type can be looked up again and kept alive for the composition
+        ThingTypePtr type;
+        {
+            std::scoped_lock l(m_mutex);
+            if (generation != m_generation)
+                return;
+
+            type = g_things.getThingType(id, category);
+        }
+
+        TexturePtr texture;
+        size_t bytes = 0;
+        if (const auto& image = type ? type->composeOutfitFrame(xPattern, zPattern, animationPhase, addons, colors) : nullptr) {
+            bytes = image->getPixels().size();
+            texture = std::make_shared<Texture>(image, true, false);
+            texture->allowAtlasCache();
+        }
+
+        std::scoped_lock l(m_mutex);
+        if (generation != m_generation)
+            return;
+
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end())
+            return;
+
+        auto& entry = it->second;
+        entry.pending = false;
+
+        if (!texture) {
+            entry.failedAt = g_clock.millis();
+            return;
+        }
+
+        entry.texture = std::move(texture);
+        entry.bytes = bytes;
+        m_lru.push_front(key);
+        entry.lru = m_lru.begin();
+        m_bytes += bytes;
+
+        evict(static_cast<size_t>(g_gameConfig.getOutfitCacheSize()) * 1024 * 1024);
+    });
+
+    return nullptr;
+}
+
+void OutfitCache::evict(const size_t budget)
+{
+    // the most recent frame always stays, even when it alone is over the budget
+    while (m_bytes > budget && m_lru.size() > 1) {
+        const auto it = m_entries.find(m_lru.back());
+        m_lru.pop_back();
+
+        m_bytes -= it->second.bytes;
+        m_entries.erase(it);
+        ++m_evictions;
+    }
+}
+
+void OutfitCache::clear()
+{
+    std::scoped_lock l(m_mutex);
+    reset();
+}
+
+void OutfitCache::reset()
+{
+    m_entries.clear();
+    m_lru.clear();
+    m_bytes = 0;
+
+    // compositions still running belong to the old sprites and are dropped
+    ++m_generation;
+}
+
+OutfitCache::Stats OutfitCache::getStats()
+{
+    std::scoped_lock l(m_mutex);
+
+    size_t pending = 0;
+    for (const auto& [key, entry] : m_entries)
+        pending += entry.pending;
+
+    return {
+        .frames = m_lru.size(),
+        .pending = pending,
+        .bytes = m_bytes,
+        .budget = static_cast<size_t>(g_gameConfig.getOutfitCacheSize()) * 1024 * 1024,
+        .hits = m_hits,
+        .misses = m_misses,
+        .evictions = m_evictions
+    };
+}
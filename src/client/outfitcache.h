@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "declarations.h"
+
+#include <list>
+#include <mutex>
+
+// Fully composed outfit frames (base sprites of the worn addons with the head, body, legs
+// and feet masks already applied) shared by every creature dressed the same way. Frames are
+// composed off thread on first use, kept within a memory budget and evicted least recently
+// used first. Until a frame is ready the creature is drawn layer by layer as before.
+class OutfitCache
+{
+public:
+    struct Stats
+    {
+        size_t frames{ 0 };
+        size_t pending{ 0 };
+        size_t bytes{ 0 };
+        size_t budget{ 0 };
+        uint64_t hits{ 0 };
+        uint64_t misses{ 0 };
+        uint64_t evictions{ 0 };
+    };
+
+    void terminate() { clear(); }
+
+    // composed frame of the outfit, null while it is being composed or when the cache is disabled
+    TexturePtr getFrame(ThingType* type, const Outfit& outfit, int xPattern, int zPattern, int animationPhase);
+
+    void clear();
+    Stats getStats();
+
+private:
+    struct Entry
+    {
+        TexturePtr texture;
+        size_t bytes{ 0 };
+        ticks_t failedAt{ 0 };
+        bool pending{ false };
+        std::list<uint64_t>::iterator lru;
+    };
+
+    void evict(size_t budget);
+    void reset();
+
+    std::mutex m_mutex;
+
+    stdext::map<uint64_t, Entry> m_entries;
+    std::list<uint64_t> m_lru; // front is the most recently drawn
+
+    size_t m_bytes{ 0 };
+    uint32_t m_generation{ 0 };
+
+    uint64_t m_hits{ 0 };
+    uint64_t m_misses{ 0 };
+    uint64_t m_evictions{ 0 };
+};
+
+extern OutfitCache g_outfitCache;
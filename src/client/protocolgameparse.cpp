@@ -1761,7 +1761,7 @@ void ProtocolGame::parseMagicEffect(const InputMessagePtr& msg)
                         return;
                     }
 
-                    const auto& missile = std::make_shared<Missile>();
+                    const auto& missile = Missile::create();
                     missile->setId(shotId);
 
                     if (effectType == Otc::MAGIC_EFFECTS_CREATE_DISTANCEEFFECT) {
@@ -1781,7 +1781,7 @@ void ProtocolGame::parseMagicEffect(const InputMessagePtr& msg)
                         continue;
                     }
 
-                    const auto& effect = std::make_shared<Effect>();
+                    const auto& effect = Effect::create();
                     effect->setId(effectId);
                     g_map.addThing(effect, pos);
                     break;
@@ -1820,7 +1820,7 @@ void ProtocolGame::parseMagicEffect(const InputMessagePtr& msg)
         return;
     }
 
-    const auto& effect = std::make_shared<Effect>();
+    const auto& effect = Effect::create();
     effect->setId(effectId);
 
     g_map.addThing(effect, pos);
@@ -1843,7 +1843,7 @@ void ProtocolGame::parseAnimatedText(const InputMessagePtr& msg)
     const uint8_t color = msg->getU8();
     const auto& text = msg->getString();
 
-    g_map.addAnimatedText(std::make_shared<AnimatedText>(text, color), position);
+    g_map.addAnimatedText(AnimatedText::create(text, color), position);
 }
 
 void ProtocolGame::parseAnthem(const InputMessagePtr& msg)
@@ -1865,7 +1865,7 @@ void ProtocolGame::parseDistanceMissile(const InputMessagePtr& msg)
         return;
     }
 
-    const auto& missile = std::make_shared<Missile>();
+    const auto& missile = Missile::create();
     missile->setId(shotId);
     missile->setPath(fromPos, toPos);
 
@@ -2761,7 +2761,7 @@ void ProtocolGame::parseTextMessage(const InputMessagePtr& msg)
                     continue;
                 }
 
-                g_map.addAnimatedText(std::make_shared<AnimatedText>(std::to_string(value[j]), color[j]), pos);
+                g_map.addAnimatedText(AnimatedText::create(std::to_string(value[j]), color[j]), pos);
             }
             break;
         }
@@ -2774,7 +2774,7 @@ void ProtocolGame::parseTextMessage(const InputMessagePtr& msg)
             const uint8_t color = msg->getU8();
             text = msg->getString();
 
-            g_map.addAnimatedText(std::make_shared<AnimatedText>(std::to_string(value), color), pos);
+            g_map.addAnimatedText(AnimatedText::create(std::to_string(value), color), pos);
             break;
         }
         case Otc::MessageExp:
@@ -2785,7 +2785,7 @@ void ProtocolGame::parseTextMessage(const InputMessagePtr& msg)
             const uint8_t color = msg->getU8();
             text = msg->getString();
 
-            g_map.addAnimatedText(std::make_shared<AnimatedText>(std::to_string(value), color), pos);
+            g_map.addAnimatedText(AnimatedText::create(std::to_string(value), color), pos);
             break;
         }
         case Otc::MessageInvalid:
@@ -126,6 +126,7 @@ public:
     SpriteSheetPtr getSheetBySpriteId(int id, bool& isLoading, bool load = true);
 
     void addSpriteSheet(const SpriteSheetPtr& sheet) { m_sheets.emplace_back(sheet); }
+    const std::vector<SpriteSheetPtr>& getSpriteSheets() const { return m_sheets; }
 
     ImagePtr getSpriteImage(int id) {
         bool isLoading = false;
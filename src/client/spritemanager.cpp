@@ -23,9 +23,10 @@
 #include "spritemanager.h"
 
 #include "game.h"
+#include "outfitcache.h"
 #include "gameconfig.h"
 #include "spriteappearances.h"
-#include "framework/core/asyncdispatcher.h"
+#include "thingtype.h"
 #include "framework/core/filestream.h"
 #include "framework/core/graphicalapplication.h"
 #include "framework/core/resourcemanager.h"
@@ -54,11 +55,13 @@ void SpriteManager::reload() {
 }
 
 void SpriteManager::load() {
-    m_spritesFiles.resize(g_asyncDispatcher.get_thread_count());
-    if (g_app.isLoadingAsyncTexture()) {
-        for (auto& file : m_spritesFiles)
-            file = std::make_unique<FileStream_m>(g_resources.openFile(m_lastFileName));
-    } else (m_spritesFiles[0] = std::make_unique<FileStream_m>(g_resources.openFile(m_lastFileName)))->file->cache(true);
+    clearDecodedCache();
+    ThingType::clearOpaqueRectCache();
+    g_outfitCache.clear();
+
+    // the whole file is read once and never seeked by the decoders
+    m_spritesFile = g_resources.openFile(m_lastFileName);
+    m_spritesFile->cache(true);
 }
 
 bool SpriteManager::loadSpr(std::string file)
@@ -210,7 +213,8 @@ void SpriteManager::unload()
 {
     m_spritesCount = 0;
     m_signature = 0;
-    m_spritesFiles.clear();
+    m_spritesFile = nullptr;
+    clearDecodedCache();
 }
 
 ImagePtr SpriteManager::getSpriteImage(const int id, bool& isLoading)
@@ -219,138 +223,193 @@ ImagePtr SpriteManager::getSpriteImage(const int id, bool& isLoading)
         return g_spriteAppearances.getSpriteImage(id, isLoading);
     }
 
-    const auto threadId = g_app.isLoadingAsyncTexture() ? stdext::getThreadId() : 0;
-    if (const auto& sf = m_spritesFiles[threadId % m_spritesFiles.size()]) {
-        if (sf->m_loadingState.exchange(SpriteLoadState::LOADING, std::memory_order_acq_rel) == SpriteLoadState::LOADING) {
-            isLoading = true;
-            return nullptr;
-        }
+    if (!m_spritesFile || id == 0)
+        return nullptr;
 
-        auto image = m_spritesHd ? getSpriteImageHd(id, sf->file) : getSpriteImage(id, sf->file);
+    // callers may modify the returned image (e.g. overwriteMask), so always hand out a copy
+    if (const auto& cached = getCachedSpriteImage(id))
+        return std::make_shared<Image>(*cached);
 
-        sf->m_loadingState.store(SpriteLoadState::LOADED, std::memory_order_release);
+    const auto& image = m_spritesHd ? getSpriteImageHd(id) : getSpriteImageRegular(id);
+    if (image)
+        cacheSpriteImage(id, std::make_shared<Image>(*image));
 
-        return image;
-    }
+    return image;
+}
 
-    return nullptr;
+void SpriteManager::setDecodedCacheLimit(const size_t bytes)
+{
+    std::scoped_lock l(m_decodedCache.mutex);
+    m_decodedCache.limit = bytes;
+    trimDecodedCache();
 }
 
-ImagePtr SpriteManager::getSpriteImageHd(const int id, const FileStreamPtr& file)
+size_t SpriteManager::getDecodedCacheSize()
 {
-    const auto it = m_cwmSpritesMetadata.find(id);
-    if (it == m_cwmSpritesMetadata.end())
+    std::scoped_lock l(m_decodedCache.mutex);
+    return m_decodedCache.size;
+}
+
+void SpriteManager::clearDecodedCache()
+{
+    std::scoped_lock l(m_decodedCache.mutex);
+    m_decodedCache.lru.clear();
+    m_decodedCache.entries.clear();
+    m_decodedCache.size = 0;
+}
+
+ImagePtr SpriteManager::getCachedSpriteImage(const uint32_t id)
+{
+    std::scoped_lock l(m_decodedCache.mutex);
+    const auto it = m_decodedCache.entries.find(id);
+    if (it == m_decodedCache.entries.end())
         return nullptr;
 
-    const auto& metadata = it->second;
+    m_decodedCache.lru.splice(m_decodedCache.lru.begin(), m_decodedCache.lru, it->second);
+    return it->second->second;
+}
 
-    std::string buffer(metadata.getFileSize(), 0);
+void SpriteManager::cacheSpriteImage(const uint32_t id, const ImagePtr& image)
+{
+    const size_t bytes = image->getPixels().size();
 
-    file->seek(m_spritesOffset + metadata.getOffset());
-    file->read(buffer.data(), metadata.getFileSize());
+    std::scoped_lock l(m_decodedCache.mutex);
+    if (bytes > m_decodedCache.limit || m_decodedCache.entries.contains(id))
+        return;
 
-    return Image::loadPNG(buffer.data(), buffer.size());
+    m_decodedCache.lru.emplace_front(id, image);
+    m_decodedCache.entries.emplace(id, m_decodedCache.lru.begin());
+    m_decodedCache.size += bytes;
+    trimDecodedCache();
 }
 
-uint16_t readU16FromBuffer(const uint8_t* data, size_t& offset) {
-    uint16_t val = data[offset] | (data[offset + 1] << 8);
-    offset += 2;
-    return val;
+void SpriteManager::trimDecodedCache()
+{
+    while (m_decodedCache.size > m_decodedCache.limit && !m_decodedCache.lru.empty()) {
+        const auto& [id, image] = m_decodedCache.lru.back();
+        m_decodedCache.size -= image->getPixels().size();
+        m_decodedCache.entries.erase(id);
+        m_decodedCache.lru.pop_back();
+    }
 }
 
-ImagePtr SpriteManager::getSpriteImage(const int id, const FileStreamPtr& file)
+ImagePtr SpriteManager::getSpriteImageHd(const int id) const
 {
-    if (id == 0 || !file)
+    const auto it = m_cwmSpritesMetadata.find(id);
+    if (it == m_cwmSpritesMetadata.end())
         return nullptr;
 
-    try {
-        file->seek(((id - 1) * 4) + m_spritesOffset);
-        const uint32_t spriteAddress = file->getU32();
-        if (spriteAddress == 0)
-            return nullptr;
-
-        file->seek(spriteAddress);
-        file->skip(3); // Skip RGB color key
-
-        const uint16_t pixelDataSize = file->getU16();
-        const int spriteSize = g_gameConfig.getSpriteSize();
-        const int totalPixels = spriteSize * spriteSize;
-        const int maxWriteSize = totalPixels * 4;
-
-        const bool useAlpha = g_game.getFeature(Otc::GameSpritesAlphaChannel);
-        const uint8_t channels = useAlpha ? 4 : 3;
-
-        static thread_local std::vector<uint8_t> spriteBuffer;
-        spriteBuffer.resize(pixelDataSize);
-        file->read(spriteBuffer.data(), pixelDataSize);
-
-        size_t offset = 0;
-        auto image = std::make_shared<Image>(Size(spriteSize));
-        uint8_t* pixels = image->getPixelData();
-        int writePos = 0;
-        bool hasAlpha = false;
-        int transparentCount = 0;
-
-        static constexpr int MAX_PIXEL_BLOCK = 4096;
-        static thread_local uint8_t tempBuffer[MAX_PIXEL_BLOCK * 4];
-
-        while (offset + 4 <= pixelDataSize && writePos < maxWriteSize) {
-            const uint16_t transparentPixels = readU16FromBuffer(spriteBuffer.data(), offset);
-            const uint16_t coloredPixels = readU16FromBuffer(spriteBuffer.data(), offset);
-
-            transparentCount += transparentPixels;
-
-            const int transparentBytes = transparentPixels * 4;
-            if (writePos + transparentBytes > maxWriteSize)
-                break;
-
-            std::memset(pixels + writePos, 0, transparentBytes);
-            writePos += transparentBytes;
-
-            const int actualColoredPixels = (coloredPixels > MAX_PIXEL_BLOCK) ? MAX_PIXEL_BLOCK : coloredPixels;
-            const int bytesToRead = actualColoredPixels * channels;
-
-            if (offset + bytesToRead > pixelDataSize)
-                break;
-
-            std::memcpy(tempBuffer, spriteBuffer.data() + offset, bytesToRead);
-            offset += bytesToRead;
-
-            if (useAlpha) {
-                for (int i = 0, src = 0; i < actualColoredPixels && writePos + 4 <= maxWriteSize; ++i, src += 4) {
-                    pixels[writePos + 0] = tempBuffer[src + 0];
-                    pixels[writePos + 1] = tempBuffer[src + 1];
-                    pixels[writePos + 2] = tempBuffer[src + 2];
-                    const uint8_t alpha = tempBuffer[src + 3];
-                    pixels[writePos + 3] = alpha;
-
-                    if (alpha != 0xFF) hasAlpha = true;
-                    else if (transparentCount <= 4 && alpha == 0x00) ++transparentCount;
-
-                    writePos += 4;
-                }
-            } else {
-                for (int i = 0, src = 0; i < actualColoredPixels && writePos + 4 <= maxWriteSize; ++i, src += 3) {
-                    pixels[writePos + 0] = tempBuffer[src + 0];
-                    pixels[writePos + 1] = tempBuffer[src + 1];
-                    pixels[writePos + 2] = tempBuffer[src + 2];
-                    pixels[writePos + 3] = 0xFF;
-                    writePos += 4;
-                }
-            }
-        }
+    const auto& metadata = it->second;
+    const auto& data = m_spritesFile->m_data;
 
-        if (writePos < maxWriteSize) {
-            std::memset(pixels + writePos, 0, maxWriteSize - writePos);
-            transparentCount += maxWriteSize - writePos;
-        }
+    const size_t start = static_cast<size_t>(m_spritesOffset) + metadata.getOffset();
+    if (start + metadata.getFileSize() > data.size()) {
+        g_logger.error("Failed to get sprite id {}: out of file bounds", id);
+        return nullptr;
+    }
 
-        if (hasAlpha || transparentCount > 4)
-            image->setTransparentPixel(true);
+    return Image::loadPNG(reinterpret_cast<const char*>(data.data() + start), metadata.getFileSize());
+}
 
-        return image;
-    } catch (const stdext::exception& e) {
-        g_logger.error("Failed to get sprite id {}: {}", id, e.what());
+ImagePtr SpriteManager::getSpriteImageRegular(const int id) const
+{
+    if (id == 0 || static_cast<uint32_t>(id) > m_spritesCount)
+        return nullptr;
+
+    const auto& data = m_spritesFile->m_data;
+
+    const size_t addressPos = static_cast<size_t>(id - 1) * 4 + m_spritesOffset;
+    if (addressPos + 4 > data.size())
+        return nullptr;
+
+    const uint32_t spriteAddress = stdext::readULE32(&data[addressPos]);
+    if (spriteAddress == 0)
+        return nullptr;
+
+    // skip RGB color key
+    if (static_cast<size_t>(spriteAddress) + 5 > data.size()) {
+        g_logger.error("Failed to get sprite id {}: out of file bounds", id);
+        return nullptr;
+    }
+
+    const uint16_t pixelDataSize = stdext::readULE16(&data[spriteAddress + 3]);
+    if (static_cast<size_t>(spriteAddress) + 5 + pixelDataSize > data.size()) {
+        g_logger.error("Failed to get sprite id {}: out of file bounds", id);
         return nullptr;
     }
-}
\ No newline at end of file
+
+    const uint8_t* spriteBuffer = &data[spriteAddress + 5];
+
+    const int spriteSize = g_gameConfig.getSpriteSize();
+    const int totalPixels = spriteSize * spriteSize;
+    const int maxWriteSize = totalPixels * 4;
+
+    const bool useAlpha = g_game.getFeature(Otc::GameSpritesAlphaChannel);
+    const uint8_t channels = useAlpha ? 4 : 3;
+
+    size_t offset = 0;
+    auto image = std::make_shared<Image>(Size(spriteSize));
+    uint8_t* pixels = image->getPixelData();
+    int writePos = 0;
+    bool hasAlpha = false;
+    int transparentCount = 0;
+
+    static constexpr int MAX_PIXEL_BLOCK = 4096;
+
+    while (offset + 4 <= pixelDataSize && writePos < maxWriteSize) {
+        const uint16_t transparentPixels = stdext::readULE16(spriteBuffer + offset);
+        const uint16_t coloredPixels = stdext::readULE16(spriteBuffer + offset + 2);
+        offset += 4;
+
+        transparentCount += transparentPixels;
+
+        const int transparentBytes = transparentPixels * 4;
+        if (writePos + transparentBytes > maxWriteSize)
+            break;
+
+        std::memset(pixels + writePos, 0, transparentBytes);
+        writePos += transparentBytes;
+
+        const int actualColoredPixels = (coloredPixels > MAX_PIXEL_BLOCK) ? MAX_PIXEL_BLOCK : coloredPixels;
+        const int bytesToRead = actualColoredPixels * channels;
+
+        if (offset + bytesToRead > pixelDataSize)
+            break;
+
+        const uint8_t* colors = spriteBuffer + offset;
+        offset += bytesToRead;
+
+        if (useAlpha) {
+            for (int i = 0, src = 0; i < actualColoredPixels && writePos + 4 <= maxWriteSize; ++i, src += 4) {
+                pixels[writePos + 0] = colors[src + 0];
+                pixels[writePos + 1] = colors[src + 1];
+                pixels[writePos + 2] = colors[src + 2];
+                const uint8_t alpha = colors[src + 3];
+                pixels[writePos + 3] = alpha;
+
+                if (alpha != 0xFF) hasAlpha = true;
+                else if (transparentCount <= 4 && alpha == 0x00) ++transparentCount;
+
+                writePos += 4;
+            }
+        } else {
+            for (int i = 0, src = 0; i < actualColoredPixels && writePos + 4 <= maxWriteSize; ++i, src += 3) {
+                pixels[writePos + 0] = colors[src + 0];
+                pixels[writePos + 1] = colors[src + 1];
+                pixels[writePos + 2] = colors[src + 2];
+                pixels[writePos + 3] = 0xFF;
+                writePos += 4;
+            }
+        }
+    }
+
+    if (writePos < maxWriteSize) {
+        std::memset(pixels + writePos, 0, maxWriteSize - writePos);
+        transparentCount += maxWriteSize - writePos;
+    }
+
+    if (hasAlpha || transparentCount > 4)
+        image->setTransparentPixel(true);
+
+    return image;
+}
@@ -25,6 +25,8 @@
 #include <framework/core/declarations.h>
 #include <framework/graphics/declarations.h>
 
+#include <mutex>
+
 class FileMetadata
 {
 public:
@@ -70,29 +72,32 @@ public:
     ImagePtr getSpriteImage(int id, bool& isLoading);
     bool isLoaded() { return m_loaded; }
 
+    // decoded legacy sprites are kept in a LRU cache, 0 disables it
+    void setDecodedCacheLimit(size_t bytes);
+    size_t getDecodedCacheLimit() { return m_decodedCache.limit; }
+    size_t getDecodedCacheSize();
+    void clearDecodedCache();
+
 private:
-    enum class SpriteLoadState
+    struct DecodedCache
     {
-        NONE,
-        LOADING,
-        LOADED
+        std::mutex mutex;
+        std::list<std::pair<uint32_t, ImagePtr>> lru; // most recently used first
+        stdext::map<uint32_t, std::list<std::pair<uint32_t, ImagePtr>>::iterator> entries;
+        size_t limit{ 64 * 1024 * 1024 };
+        size_t size{ 0 };
     };
 
-    struct FileStream_m
-    {
-        FileStreamPtr file;
-        std::atomic<SpriteLoadState> m_loadingState = SpriteLoadState::NONE;
-
-        FileStream_m(FileStreamPtr f) : file(std::move(f)) {}
-    };
+    ImagePtr getCachedSpriteImage(uint32_t id);
+    void cacheSpriteImage(uint32_t id, const ImagePtr& image);
+    void trimDecodedCache();
 
     void load();
-    FileStreamPtr getSpriteFile() const {
-        return m_spritesFiles[0]->file;
-    }
+    FileStreamPtr getSpriteFile() const { return m_spritesFile; }
 
-    ImagePtr getSpriteImageHd(int id, const FileStreamPtr& file);
-    ImagePtr getSpriteImage(int id, const FileStreamPtr& file);
+    // decoders only read from the immutable file buffer, so any number of threads may run them at once
+    ImagePtr getSpriteImageHd(int id) const;
+    ImagePtr getSpriteImageRegular(int id) const;
 
     std::string m_lastFileName;
 
@@ -102,8 +107,10 @@ private:
     uint32_t m_spritesCount{ 0 };
     uint32_t m_spritesOffset{ 0 };
 
-    std::vector<std::unique_ptr<FileStream_m>> m_spritesFiles;
+    FileStreamPtr m_spritesFile;
     std::unordered_map<uint32_t, FileMetadata> m_cwmSpritesMetadata;
+
+    DecodedCache m_decodedCache;
 };
 
 extern SpriteManager g_sprites;
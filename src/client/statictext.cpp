@@ -28,6 +28,7 @@
 #include "framework/core/eventdispatcher.h"
 #include "framework/core/graphicalapplication.h"
 #include "framework/graphics/fontmanager.h"
+#include "framework/graphics/textbatch.h"
 
 StaticText::StaticText()
 {
@@ -35,7 +36,25 @@ StaticText::StaticText()
     m_cachedText.setAlign(Fw::AlignCenter);
 }
 
+StaticTextPtr StaticText::create()
+{
+    return std::allocate_shared<StaticText>(stdext::recycling_allocator<StaticText>());
+}
+
 void StaticText::drawText(const Point& dest, const Rect& parentRect)
+{
+    m_cachedText.draw(getTextRect(dest, parentRect), m_color);
+}
+
+void StaticText::drawText(const Point& dest, const Rect& parentRect, TextBatch& batch)
+{
+    // draw only if the real center is not too far from the parent center, or its a yell
+    //if(g_map.isAwareOfPosition(m_position) || isYell()) {
+    batch.add(m_cachedText, getTextRect(dest, parentRect), m_color);
+    //}
+}
+
+Rect StaticText::getTextRect(const Point& dest, const Rect& parentRect) const
 {
     const auto& textSize = m_cachedText.getTextSize();
 
@@ -43,10 +62,7 @@ void StaticText::drawText(const Point& dest, const Rect& parentRect)
     if (g_app.getStaticTextScale() == DEFAULT_DISPLAY_DENSITY)
         rect.bind(parentRect);
 
-    // draw only if the real center is not too far from the parent center, or its a yell
-    //if(g_map.isAwareOfPosition(m_position) || isYell()) {
-    m_cachedText.draw(rect, m_color);
-    //}
+    return rect;
 }
 
 void StaticText::setText(const std::string_view text) { m_cachedText.setText(text); }
@@ -34,7 +34,10 @@ class StaticText final : public LuaObject
 public:
     StaticText();
 
+    static StaticTextPtr create();
+
     void drawText(const Point& dest, const Rect& parentRect);
+    void drawText(const Point& dest, const Rect& parentRect, TextBatch& batch);
 
     std::string getName() { return m_name; }
     std::string getText() { return m_cachedText.getText(); }
@@ -59,6 +62,8 @@ public:
     void setPosition(const Position& position) { m_position = position; }
 
 private:
+    Rect getTextRect(const Point& dest, const Rect& parentRect) const;
+
     void update();
     void scheduleUpdate();
     void compose();
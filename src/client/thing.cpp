@@ -462,6 +462,11 @@ bool Thing::isOpaque() const {
         return t->isOpaque();
     return false;
 }
+bool Thing::isOpacityKnown() const {
+    if (const auto t = getThingType(); t)
+        return t->isOpacityKnown();
+    return true;
+}
 bool Thing::isLoading() const {
     if (const auto t = getThingType(); t)
         return t->isLoading();
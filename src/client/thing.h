@@ -142,6 +142,7 @@ public:
     bool isPodium() const;
     bool isOpaque() const;
     bool isLoading() const;
+    bool isOpacityKnown() const;
     bool isSingleDimension() const;
     bool isTall(bool useRealSize = false) const;
 
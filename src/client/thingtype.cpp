@@ -35,6 +35,13 @@
 #include "framework/otml/otmlnode.h"
 #include <framework/core/graphicalapplication.h>
 
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPAQUE_SCAN_SSE2
+#endif
+
 const static TexturePtr m_textureNull;
 
 namespace {
@@ -48,6 +55,124 @@ namespace {
             default: return "unknown";
         }
     }
+
+    // alpha bytes of two RGBA pixels read as one word, built from bytes so it holds on any byte order
+    const uint64_t PIXEL_PAIR_ALPHA_MASK = [] {
+        constexpr uint8_t bytes[8] = { 0, 0, 0, 0xFF, 0, 0, 0, 0xFF };
+        uint64_t mask;
+        std::memcpy(&mask, bytes, sizeof(mask));
+        return mask;
+    }();
+
+    // first pixel of [x, right] with a non zero alpha, -1 if there is none
+    int findOpaquePixel(const uint8_t* row, int x, const int right)
+    {
+#ifdef OPAQUE_SCAN_SSE2
+        // four pixels per test, movemask yields one bit per byte in memory order
+        const __m128i zero = _mm_setzero_si128();
+        for (; x + 3 <= right; x += 4) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+            if (const int alpha = ~_mm_movemask_epi8(_mm_cmpeq_epi8(pixels, zero)) & 0x8888)
+                return x + (std::countr_zero(static_cast<uint32_t>(alpha)) >> 2);
+        }
+#endif
+        for (; x + 1 <= right; x += 2) {
+            uint64_t word;
+            std::memcpy(&word, row + x * 4, sizeof(word));
+            if (word & PIXEL_PAIR_ALPHA_MASK)
+                return row[x * 4 + 3] ? x : x + 1;
+        }
+
+        if (x == right && row[x * 4 + 3])
+            return x;
+
+        return -1;
+    }
+
+    // scans alpha row by row and returns the opaque bounds of area
+    Rect scanOpaqueRect(const uint8_t* pixels, const int stride, const Rect& area)
+    {
+        int top = -1, bottom = -1, left = area.right() + 1, right = area.left() - 1;
+        for (int y = area.top(); y <= area.bottom(); ++y) {
+            const uint8_t* row = pixels + (static_cast<size_t>(y) * stride) * 4;
+
+            const int first = findOpaquePixel(row, area.left(), area.right());
+            if (first == -1)
+                continue;
+
+            if (top == -1)
+                top = y;
+            bottom = y;
+            left = std::min<int>(left, first);
+
+            // only the columns right of the current bound can still widen it
+            for (int lx = area.right(); lx > right && lx >= first; --lx) {
+                if (row[lx * 4 + 3]) {
+                    right = lx;
+                    break;
+                }
+            }
+        }
+
+        if (top == -1)
+            return {};
+
+        return { Point(left, top), Point(right, bottom) };
+    }
+
+    // opaque bounds of each sprite, relative to the sprite, keyed by sprite id and mask layer;
+    // dropped whole once it holds MAX_OPAQUE_RECTS entries, loaded things keep their merged rects
+    constexpr size_t MAX_OPAQUE_RECTS = 1 << 16;
+    std::mutex g_opaqueRectsMutex;
+    stdext::map<uint64_t, Rect> g_opaqueRects;
+
+    Rect getSpriteOpaqueRect(const uint32_t spriteId, const uint8_t maskLayer, const ImagePtr& spriteImage)
+    {
+        const uint64_t key = static_cast<uint64_t>(maskLayer) << 32 | spriteId;
+        {
+            std::scoped_lock l(g_opaqueRectsMutex);
+            if (const auto it = g_opaqueRects.find(key); it != g_opaqueRects.end())
+                return it->second;
+        }
+
+        const auto& rect = scanOpaqueRect(spriteImage->getPixelData(), spriteImage->getWidth(), Rect(0, 0, spriteImage->getSize()));
+
+        std::scoped_lock l(g_opaqueRectsMutex);
+        if (g_opaqueRects.size() >= MAX_OPAQUE_RECTS)
+            g_opaqueRects.clear();
+        g_opaqueRects.emplace(key, rect);
+        return rect;
+    }
+
+    void mergeOpaqueRect(Rect& rects, const Rect& frame, const Rect& opaque)
+    {
+        if (!opaque.isValid())
+            return;
+
+        const auto& clipped = opaque.intersection(frame);
+        if (!clipped.isValid())
+            return;
+
+        rects.setTop(std::min<int>(clipped.top(), rects.top()));
+        rects.setLeft(std::min<int>(clipped.left(), rects.left()));
+        rects.setBottom(std::max<int>(clipped.bottom(), rects.bottom()));
+        rects.setRight(std::max<int>(clipped.right(), rects.right()));
+    }
+
+    // FileStream::addString is limited by its u16 length, descriptions may not fit
+    void addSnapshotString(const FileStreamPtr& fin, const std::string_view str)
+    {
+        fin->addU32(str.size());
+        fin->write(str.data(), str.size());
+    }
+
+    std::string getSnapshotString(const FileStreamPtr& fin)
+    {
+        std::string str(fin->getU32(), '\0');
+        if (!str.empty() && fin->read(str.data(), str.size()) != 1)
+            throw Exception("snapshot string is truncated");
+        return str;
+    }
 }
 
 void ThingType::unserializeAppearance(const uint16_t clientId, const ThingCategory category, const appearances::Appearance& appearance)
@@ -111,6 +236,146 @@ void ThingType::unserializeAppearance(const uint16_t clientId, const ThingCatego
     }
 }
 
+void ThingType::serializeSnapshot(const FileStreamPtr& fin) const
+{
+    addSnapshotString(fin, m_name);
+    addSnapshotString(fin, m_description);
+
+    fin->addU64(m_flags);
+    fin->add8(m_opaque);
+    fin->add32(m_size.width());
+    fin->add32(m_size.height());
+    fin->add32(m_displacement.x);
+    fin->add32(m_displacement.y);
+
+    fin->addU8(m_animationPhases);
+    fin->addU8(m_realSize);
+    fin->addU8(m_numPatternX);
+    fin->addU8(m_numPatternY);
+    fin->addU8(m_numPatternZ);
+    fin->addU8(m_layers);
+    fin->addU8(m_minimapColor);
+    fin->addU8(m_clothSlot);
+    fin->addU8(m_lensHelp);
+    fin->addU8(m_elevation);
+    fin->addU8(m_defaultAction);
+
+    fin->addU16(m_groundSpeed);
+    fin->addU16(m_maxTextLength);
+    fin->addU16(m_upgradeClassification);
+
+    fin->addU8(m_light.intensity);
+    fin->addU8(m_light.color);
+
+    addSnapshotString(fin, m_market.name);
+    fin->addU16(m_market.category);
+    fin->addU16(m_market.requiredLevel);
+    fin->addU16(m_market.restrictVocation);
+    fin->addU16(m_market.showAs);
+    fin->addU16(m_market.tradeAs);
+
+    fin->addU16(m_npcData.size());
+    for (const auto& npc : m_npcData) {
+        addSnapshotString(fin, npc.name);
+        addSnapshotString(fin, npc.location);
+        fin->addU32(npc.salePrice);
+        fin->addU32(npc.buyPrice);
+        fin->addU32(npc.currencyObjectTypeId);
+        addSnapshotString(fin, npc.currencyQuestFlagDisplayName);
+    }
+
+    fin->addU8(m_animator != nullptr);
+    if (m_animator)
+        m_animator->serializeSnapshot(fin);
+
+    fin->addU8(m_idleAnimator != nullptr);
+    if (m_idleAnimator)
+        m_idleAnimator->serializeSnapshot(fin);
+
+    fin->addU32(m_spritesIndex.size());
+    fin->write(m_spritesIndex.data(), m_spritesIndex.size() * sizeof(uint32_t));
+}
+
+void ThingType::unserializeSnapshot(const uint16_t clientId, const ThingCategory category, const FileStreamPtr& fin)
+{
+    m_null = false;
+    m_id = clientId;
+    m_category = category;
+
+    m_name = getSnapshotString(fin);
+    m_description = getSnapshotString(fin);
+
+    m_flags = fin->getU64();
+    m_opaque = fin->get8();
+
+    const int width = fin->get32();
+    const int height = fin->get32();
+    m_size = { width, height };
+
+    const int displacementX = fin->get32();
+    const int displacementY = fin->get32();
+    m_displacement = { displacementX, displacementY };
+
+    m_animationPhases = fin->getU8();
+    m_realSize = fin->getU8();
+    m_numPatternX = fin->getU8();
+    m_numPatternY = fin->getU8();
+    m_numPatternZ = fin->getU8();
+    m_layers = fin->getU8();
+    m_minimapColor = fin->getU8();
+    m_clothSlot = fin->getU8();
+    m_lensHelp = fin->getU8();
+    m_elevation = fin->getU8();
+    m_defaultAction = static_cast<PLAYER_ACTION>(fin->getU8());
+
+    m_groundSpeed = fin->getU16();
+    m_maxTextLength = fin->getU16();
+    m_upgradeClassification = fin->getU16();
+
+    m_light.intensity = fin->getU8();
+    m_light.color = fin->getU8();
+
+    m_market.name = getSnapshotString(fin);
+    m_market.category = static_cast<ITEM_CATEGORY>(fin->getU16());
+    m_market.requiredLevel = fin->getU16();
+    m_market.restrictVocation = fin->getU16();
+    m_market.showAs = fin->getU16();
+    m_market.tradeAs = fin->getU16();
+
+    const uint16_t npcCount = fin->getU16();
+    m_npcData.reserve(npcCount);
+    for (int i = 0; i < npcCount; ++i) {
+        NPCData data;
+        data.name = getSnapshotString(fin);
+        data.location = getSnapshotString(fin);
+        data.salePrice = fin->getU32();
+        data.buyPrice = fin->getU32();
+        data.currencyObjectTypeId = fin->getU32();
+        data.currencyQuestFlagDisplayName = getSnapshotString(fin);
+        m_npcData.emplace_back(std::move(data));
+    }
+
+    if (fin->getU8()) {
+        m_animator = new Animator;
+        m_animator->unserializeSnapshot(fin);
+    }
+
+    if (fin->getU8()) {
+        m_idleAnimator = new Animator;
+        m_idleAnimator->unserializeSnapshot(fin);
+    }
+
+    const uint32_t spritesCount = fin->getU32();
+    if (spritesCount > 4096)
+        throw Exception("a thing type has more than 4096 sprites");
+
+    m_spritesIndex.resize(spritesCount);
+    if (spritesCount > 0 && fin->read(m_spritesIndex.data(), spritesCount * sizeof(uint32_t)) != 1)
+        throw Exception("snapshot sprites are truncated");
+
+    m_textureData.resize(m_animationPhases);
+}
+
 void ThingType::applyAppearanceFlags(const appearances::AppearanceFlags& flags)
 {
     if (flags.has_bank()) {
@@ -647,6 +912,7 @@ void ThingType::draw(const Point& dest, const int layer, const int xPattern, con
 
     const auto& texture = getTexture(animationFrameId);
     if (!texture) {
+        g_drawPool.invalidateCapture(); // still loading, don't let a replay keep it blank
         return; // texture might not exists, neither its rects.
     }
 
@@ -675,6 +941,88 @@ void ThingType::draw(const Point& dest, const int layer, const int xPattern, con
     }
 }
 
+ImagePtr ThingType::composeOutfitFrame(const int xPattern, const int zPattern, const int animationPhase, const uint8_t addons, const std::array<Color, 4>& colors)
+{
+    if (m_null || m_category != ThingCategoryCreature || m_layers < 2 || m_animationPhases == 0)
+        return nullptr;
+
+    const int spriteSize = g_gameConfig.getSpriteSize();
+    const bool protobufSupported = g_game.isUsingProtobuf();
+
+    // same sprite placement as loadTexture, for a single frame
+    const auto& blitLayer = [&](Image& target, const int l, const int y) {
+        const int wCount = protobufSupported ? 1 : m_size.width();
+        const int hCount = protobufSupported ? 1 : m_size.height();
+        for (int h = 0; h < hCount; ++h) {
+            for (int w = 0; w < wCount; ++w) {
+                const auto spriteId = m_spritesIndex[protobufSupported ? getSpriteIndex(-1, -1, l, xPattern, y, zPattern, animationPhase) : getSpriteIndex(w, h, l, xPattern, y, zPattern, animationPhase)];
+
+                bool isLoading = false;
+                const auto& spriteImage = g_sprites.getSpriteImage(spriteId, isLoading);
+                if (isLoading || (!spriteImage && spriteId != 0))
+                    return false;
+
+                if (!spriteImage)
+                    continue;
+
+                const auto& spritePos = protobufSupported
+                    ? Point(m_size.width(), m_size.height()) - (spriteImage->getSize() / spriteSize).toPoint()
+                    : Point(m_size.width() - w - 1, m_size.height() - h - 1);
+                target.blit(spritePos * spriteSize, spriteImage);
+            }
+        }
+        return true;
+    };
+
+    // template colors of the mask sprite, in the order of the colors argument
+    static const uint32_t maskColors[] = { Color::yellow.rgba(), Color::red.rgba(), Color::green.rgba(), Color::blue.rgba() };
+
+    const Size frameSize = m_size * spriteSize;
+    const auto& frame = std::make_shared<Image>(frameSize);
+
+    for (int y = 0; y < m_numPatternY; ++y) {
+        // yPattern => creature addon
+        if (y > 0 && !(addons & (1 << (y - 1))))
+            continue;
+
+        const auto& layer = std::make_shared<Image>(frameSize);
+        const auto& mask = std::make_shared<Image>(frameSize);
+        if (!blitLayer(*layer, 0, y) || !blitLayer(*mask, 1, y))
+            return nullptr;
+
+        // what the MULTIPLY pass of Creature::internalDraw does on the gpu
+        uint8_t* pixels = layer->getPixelData();
+        const uint8_t* maskPixels = mask->getPixelData();
+        for (int p = 0, s = layer->getPixelCount(); p < s; ++p) {
+            uint32_t maskPixel;
+            std::memcpy(&maskPixel, maskPixels + p * 4, sizeof(maskPixel));
+            if (maskPixel == 0)
+                continue;
+
+            for (int c = 0; c < 4; ++c) {
+                if (maskPixel != maskColors[c])
+                    continue;
+
+                uint8_t* pixel = pixels + p * 4;
+                pixel[0] = pixel[0] * colors[c].r() / 255;
+                pixel[1] = pixel[1] * colors[c].g() / 255;
+                pixel[2] = pixel[2] * colors[c].b() / 255;
+                break;
+            }
+        }
+
+        frame->blit(Point(), layer);
+    }
+
+    return frame;
+}
+
+void ThingType::drawComposedFrame(const Point& dest, const TexturePtr& frame, const Color& color)
+{
+    const Rect screenRect(dest - (m_displacement + (m_size.toPoint() - Point(1)) * g_gameConfig.getSpriteSize()) * g_drawPool.getScaleFactor(), frame->getSize() * g_drawPool.getScaleFactor());
+    g_drawPool.addTexturedRect(screenRect, frame, Rect(Point(), frame->getSize()), m_opacity < 1.0f ? Color(color, m_opacity) : color);
+}
+
 const TexturePtr& ThingType::getTexture(const int animationPhase)
 {
     if (m_null) return m_textureNull;
@@ -710,6 +1058,12 @@ const TexturePtr& ThingType::getTexture(const int animationPhase)
     return m_textureNull;
 }
 
+void ThingType::clearOpaqueRectCache()
+{
+    std::scoped_lock l(g_opaqueRectsMutex);
+    g_opaqueRects.clear();
+}
+
 void ThingType::loadTexture(const int animationPhase)
 {
     auto& textureData = m_textureData[animationPhase];
@@ -734,6 +1088,7 @@ void ThingType::loadTexture(const int animationPhase)
     static Color maskColors[] = { Color::red, Color::green, Color::blue, Color::yellow };
 
     textureData.pos.resize(indexSize);
+    std::vector<bool> framesStarted(indexSize, false);
     for (int z = 0; z < m_numPatternZ; ++z) {
         for (int y = 0; y < m_numPatternY; ++y) {
             for (int x = 0; x < m_numPatternX; ++x) {
@@ -743,6 +1098,15 @@ void ThingType::loadTexture(const int animationPhase)
 
                     const auto& framePos = Point(frameIndex % (textureSize.width() / m_size.width()) * m_size.width(),
                         frameIndex / (textureSize.width() / m_size.width()) * m_size.height()) * g_gameConfig.getSpriteSize();
+                    const auto& frameRect = Rect(framePos, Size(m_size.width(), m_size.height()) * g_gameConfig.getSpriteSize());
+
+                    // opaque bounds are accumulated from every sprite blitted into the frame, layers of
+                    // common items share the same frame.
+                    auto& posData = textureData.pos[frameIndex];
+                    if (!framesStarted[frameIndex]) {
+                        framesStarted[frameIndex] = true;
+                        posData.rects = { frameRect.bottomRight(), framePos };
+                    }
 
                     if (!useCustomImage) {
                         if (protobufSupported) {
@@ -773,6 +1137,7 @@ void ThingType::loadTexture(const int animationPhase)
 
                                 const Point& spritePos = Point(m_size.width() - spriteSize.width(), m_size.height() - spriteSize.height()) * g_gameConfig.getSpriteSize();
                                 fullImage->blit(framePos + spritePos, spriteImage);
+                                mergeOpaqueRect(posData.rects, frameRect, getSpriteOpaqueRect(spriteId, spriteMask ? l : 0, spriteImage).translated(framePos + spritePos));
                             }
                         } else {
                             for (int h = 0; h < m_size.height(); ++h) {
@@ -802,28 +1167,16 @@ void ThingType::loadTexture(const int animationPhase)
 
                                         const Point& spritePos = Point(m_size.width() - w - 1, m_size.height() - h - 1) * g_gameConfig.getSpriteSize();
                                         fullImage->blit(framePos + spritePos, spriteImage);
+                                        mergeOpaqueRect(posData.rects, frameRect, getSpriteOpaqueRect(spriteId, spriteMask ? l : 0, spriteImage).translated(framePos + spritePos));
                                     }
                                 }
                             }
                         }
+                    } else {
+                        mergeOpaqueRect(posData.rects, frameRect, scanOpaqueRect(fullImage->getPixelData(), fullImage->getWidth(), frameRect.intersection(Rect(0, 0, fullImage->getSize()))));
                     }
 
-                    auto& posData = textureData.pos[frameIndex];
-                    posData.rects = { framePos + Point(m_size.width(), m_size.height()) * g_gameConfig.getSpriteSize() - Point(1), framePos };
-                    for (int fx = framePos.x; fx < framePos.x + m_size.width() * g_gameConfig.getSpriteSize(); ++fx) {
-                        for (int fy = framePos.y; fy < framePos.y + m_size.height() * g_gameConfig.getSpriteSize(); ++fy) {
-                            const uint8_t* p = fullImage->getPixel(fx, fy);
-                            if (p[3] == 0x00)
-                                continue;
-
-                            posData.rects.setTop(std::min<int>(fy, posData.rects.top()));
-                            posData.rects.setLeft(std::min<int>(fx, posData.rects.left()));
-                            posData.rects.setBottom(std::max<int>(fy, posData.rects.bottom()));
-                            posData.rects.setRight(std::max<int>(fx, posData.rects.right()));
-                        }
-                    }
-
-                    posData.originRects = Rect(framePos, Size(m_size.width(), m_size.height()) * g_gameConfig.getSpriteSize());
+                    posData.originRects = frameRect;
                     posData.offsets = posData.rects.topLeft() - framePos;
                 }
             }
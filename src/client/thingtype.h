@@ -42,6 +42,9 @@ public:
     void unserializeOtml(const OTMLNodePtr& node);
     void applyAppearanceFlags(const appearances::AppearanceFlags& flags);
 
+    void serializeSnapshot(const FileStreamPtr& fin) const;
+    void unserializeSnapshot(uint16_t clientId, ThingCategory category, const FileStreamPtr& fin);
+
 #ifdef FRAMEWORK_EDITOR
     void serialize(const FileStreamPtr& fin);
     void exportImage(const std::string& fileName);
@@ -51,6 +54,11 @@ public:
 
     void drawWithFrameBuffer(const TexturePtr& texture, const Rect& screenRect, const Rect& textureRect, const Color& color);
 
+    // outfit frame with the given addons and its masks already multiplied by the head, body, legs and feet
+    // colors, null while sprites are loading. Used by the outfit cache, drawn with drawComposedFrame.
+    ImagePtr composeOutfitFrame(int xPattern, int zPattern, int animationPhase, uint8_t addons, const std::array<Color, 4>& colors);
+    void drawComposedFrame(const Point& dest, const TexturePtr& frame, const Color& color);
+
     uint16_t getId() { return m_id; }
     ThingCategory getCategory() { return m_category; }
     bool isNull() { return m_null; }
@@ -139,6 +147,7 @@ public:
     bool isTopEffect() { return (m_flags & ThingFlagAttrTopEffect); }
     bool hasAction() { return (m_flags & ThingFlagAttrDefaultAction); }
     bool isOpaque() { return m_opaque == 1; }
+    bool isOpacityKnown() const { return m_opaque != -1; }
     bool isDecoKit() { return (m_flags & ThingFlagAttrDecoKit); }
     bool isLoading() const { return m_loading.load(std::memory_order_acquire); }
     bool isAmmo() { return (m_flags & ThingFlagAttrAmmo); }
@@ -168,6 +177,9 @@ public:
     int getExactHeight();
     const TexturePtr& getTexture(int animationPhase);
 
+    // must be called whenever sprite ids may point to different pixels (sprites reloaded)
+    static void clearOpaqueRectCache();
+
     std::string getName() { return m_name; }
     std::string getDescription() { return m_description; }
 
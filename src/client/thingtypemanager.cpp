@@ -26,12 +26,15 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include "game.h"
+#include "outfitcache.h"
 #include "spriteappearances.h"
 #include "thingtype.h"
+#include "framework/core/asyncdispatcher.h"
 #include "framework/core/filestream.h"
 #include "framework/core/resourcemanager.h"
 #include "framework/otml/otmldocument.h"
 #include <staticdata.pb.h>
+#include <zlib.h>
 
 #ifdef FRAMEWORK_EDITOR
 #include "itemtype.h"
@@ -43,6 +46,27 @@ using json = nlohmann::json;
 
 ThingTypeManager g_things;
 
+namespace {
+    // bump whenever ThingType::serializeSnapshot or the layout below changes
+    constexpr uint32_t SNAPSHOT_SIGNATURE = 0x5350544F; // "OTPS"
+    constexpr uint16_t SNAPSHOT_VERSION = 2;
+
+    uint32_t snapshotHash(const std::string_view contents)
+    {
+        return ::crc32(::crc32(0, nullptr, 0), reinterpret_cast<const Bytef*>(contents.data()), contents.size());
+    }
+
+    std::string getSnapshotFile()
+    {
+        return fmt::format("/appearances-{}.snapshot", g_game.getClientVersion());
+    }
+
+    std::string getAppearancesPath(const std::string& file, const std::string& appearancesFile)
+    {
+        return g_resources.resolvePath(fmt::format("{}{}", file, appearancesFile));
+    }
+}
+
 void ThingTypeManager::init()
 {
     m_nullThingType = std::make_shared<ThingType>();
@@ -70,6 +94,8 @@ void ThingTypeManager::terminate()
 
 bool ThingTypeManager::loadDat(std::string file)
 {
+    g_outfitCache.clear();
+
     m_datLoaded = false;
     m_datSignature = 0;
     m_contentRevision = 0;
@@ -144,12 +170,23 @@ bool ThingTypeManager::loadOtml(std::string file)
 
 bool ThingTypeManager::loadAppearances(const std::string& file)
 {
+    g_outfitCache.clear();
+
     try {
         if (!g_game.getFeature(Otc::GameLoadSprInsteadProtobuf)) {
             g_spriteAppearances.unload();
+            ThingType::clearOpaqueRectCache();
+
+            const auto& catalogContents = g_resources.readFileContents(g_resources.resolvePath(g_resources.guessFilePath(file + "catalog-content", "json")));
+            const uint32_t catalogHash = snapshotHash(catalogContents);
+            if (loadAppearancesSnapshot(file, catalogHash)) {
+                m_datLoaded = true;
+                return true;
+            }
+
             int spritesCount = 0;
             std::string appearancesFile;
-            json document = json::parse(g_resources.readFileContents(g_resources.resolvePath(g_resources.guessFilePath(file + "catalog-content", "json"))));
+            json document = json::parse(catalogContents);
             for (const auto& obj : document) {
                 const auto& type = obj["type"];
                 if (type == "appearances") {
@@ -171,38 +208,15 @@ bool ThingTypeManager::loadAppearances(const std::string& file)
             g_spriteAppearances.setSpritesCount(spritesCount + 1);
             g_spriteAppearances.setPath(file);
             // load appearances.dat
-            std::stringstream fin;
-            g_resources.readFileStream(g_resources.resolvePath(fmt::format("{}{}", file, appearancesFile)), fin);
+            const auto& appearancesContents = g_resources.readFileContents(getAppearancesPath(file, appearancesFile));
             auto appearancesLib = appearances::Appearances();
-            if (!appearancesLib.ParseFromIstream(&fin)) {
+            if (!appearancesLib.ParseFromArray(appearancesContents.data(), appearancesContents.size())) {
                 throw stdext::exception("Couldn't parse appearances lib.");
             }
-            for (int category = ThingCategoryItem; category < ThingLastCategory; ++category) {
-                const google::protobuf::RepeatedPtrField<appearances::Appearance>* appearances = nullptr;
-                switch (category) {
-                    case ThingCategoryItem: appearances = &appearancesLib.object(); break;
-                    case ThingCategoryCreature: appearances = &appearancesLib.outfit(); break;
-                    case ThingCategoryEffect: appearances = &appearancesLib.effect(); break;
-                    case ThingCategoryMissile: appearances = &appearancesLib.missile(); break;
-                    default: return false;
-                }
-                // fix for custom asserts, where ids are not sorted.
-                uint32_t lastAppearanceId = 0;
-                for (const auto& appearance : *appearances) {
-                    if (appearance.id() > lastAppearanceId)
-                        lastAppearanceId = appearance.id();
-                }
-                auto& things = m_thingTypes[category];
-                things.clear();
-                things.resize(lastAppearanceId + 1, m_nullThingType);
-                for (const auto& appearance : *appearances) {
-                    const auto& type = std::make_shared<ThingType>();
-                    const uint16_t id = appearance.id();
-                    type->unserializeAppearance(id, static_cast<ThingCategory>(category), appearance);
-                    m_thingTypes[category][id] = type;
-                }
-            }
+            unserializeAppearances(appearancesLib);
             m_datLoaded = true;
+
+            saveAppearancesSnapshot(file, catalogHash, appearancesFile, snapshotHash(appearancesContents));
         } else {
             std::stringstream datFileStream;
             auto appearancesLib = appearances::Appearances();
@@ -224,6 +238,208 @@ bool ThingTypeManager::loadAppearances(const std::string& file)
     }
 }
 
+bool ThingTypeManager::loadAppearancesSnapshot(const std::string& file, const uint32_t catalogHash)
+{
+    const auto& snapshotFile = getSnapshotFile();
+    if (!g_resources.fileExists(snapshotFile))
+        return false;
+
+    try {
+        const auto& fin = g_resources.openFile(snapshotFile);
+        fin->cache();
+
+        if (fin->getU32() != SNAPSHOT_SIGNATURE || fin->getU16() != SNAPSHOT_VERSION)
+            return false;
+
+        if (fin->getString() != file || fin->getU32() != catalogHash)
+            return false;
+
+        const auto& appearancesFile = fin->getString();
+        const auto& appearancesPath = getAppearancesPath(file, appearancesFile);
+        const int64_t appearancesSize = fin->getU64();
+        const int64_t appearancesTime = fin->getU64();
+        const uint32_t appearancesHash = fin->getU32();
+
+        // size and modification time vouch for the file, only a mismatch pays for reading it
+        bool restamp = false;
+        if (g_resources.getFileSize(appearancesPath) != appearancesSize || g_resources.getFileTime(appearancesPath) != appearancesTime) {
+            if (snapshotHash(g_resources.readFileContents(appearancesPath)) != appearancesHash)
+                return false;
+
+            // same contents, the file was only touched or copied
+            restamp = true;
+        }
+
+        const int spritesCount = fin->getU32();
+        for (int i = 0, s = fin->getU32(); i < s; ++i) {
+            const int firstId = fin->getU32();
+            const int lastId = fin->getU32();
+            const auto layout = static_cast<SpriteLayout>(fin->getU8());
+            g_spriteAppearances.addSpriteSheet(std::make_shared<SpriteSheet>(firstId, lastId, layout, fin->getString()));
+        }
+
+        for (auto& things : m_thingTypes) {
+            things.clear();
+            things.resize(fin->getU32(), m_nullThingType);
+
+            for (int i = 0, s = fin->getU32(); i < s; ++i) {
+                const uint16_t id = fin->getU16();
+                const auto category = static_cast<ThingCategory>(fin->getU8());
+                if (id >= things.size())
+                    throw Exception("thing id {} out of range", id);
+
+                const auto& type = std::make_shared<ThingType>();
+                type->unserializeSnapshot(id, category, fin);
+                things[id] = type;
+            }
+        }
+
+        g_spriteAppearances.setSpritesCount(spritesCount);
+        g_spriteAppearances.setPath(file);
+
+        if (restamp) {
+            fin->close();
+            saveAppearancesSnapshot(file, catalogHash, appearancesFile, appearancesHash);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        g_logger.warning("Discarding appearances snapshot '{}': {}", snapshotFile, e.what());
+    }
+
+    for (auto& things : m_thingTypes) {
+        things.clear();
+        things.resize(1, m_nullThingType);
+    }
+    g_spriteAppearances.unload();
+    return false;
+}
+
+void ThingTypeManager::saveAppearancesSnapshot(const std::string& file, const uint32_t catalogHash, const std::string& appearancesFile, const uint32_t appearancesHash)
+{
+    const auto& snapshotFile = getSnapshotFile();
+    try {
+        const auto& fin = g_resources.createFile(snapshotFile);
+        fin->cache();
+
+        fin->addU32(SNAPSHOT_SIGNATURE);
+        fin->addU16(SNAPSHOT_VERSION);
+        fin->addString(file);
+        fin->addU32(catalogHash);
+        const auto& appearancesPath = getAppearancesPath(file, appearancesFile);
+        fin->addString(appearancesFile);
+        fin->addU64(g_resources.getFileSize(appearancesPath));
+        fin->addU64(g_resources.getFileTime(appearancesPath));
+        fin->addU32(appearancesHash);
+
+        const auto& sheets = g_spriteAppearances.getSpriteSheets();
+        fin->addU32(g_spriteAppearances.getSpritesCount());
+        fin->addU32(sheets.size());
+        for (const auto& sheet : sheets) {
+            fin->addU32(sheet->firstId);
+            fin->addU32(sheet->lastId);
+            fin->addU8(static_cast<uint8_t>(sheet->spriteLayout));
+            fin->addString(sheet->file);
+        }
+
+        for (const auto& things : m_thingTypes) {
+            fin->addU32(things.size());
+            fin->addU32(std::ranges::count_if(things, [](const ThingTypePtr& type) { return !type->isNull(); }));
+            for (const auto& type : things) {
+                if (type->isNull())
+                    continue;
+
+                fin->addU16(type->getId());
+                fin->addU8(type->getCategory());
+                type->serializeSnapshot(fin);
+            }
+        }
+
+        fin->flush();
+        fin->close();
+    } catch (const std::exception& e) {
+        g_logger.warning("Failed to write appearances snapshot '{}': {}", snapshotFile, e.what());
+    }
+}
+
+void ThingTypeManager::unserializeAppearances(const appearances::Appearances& appearancesLib)
+{
+    // number of appearances unserialized by a single worker task
+    static constexpr int CHUNK_SIZE = 2048;
+
+    struct Chunk
+    {
+        ThingCategory category;
+        const google::protobuf::RepeatedPtrField<appearances::Appearance>* appearances;
+        int begin;
+        int end;
+    };
+
+    // the slot owner is the last appearance declaring that id, same as the sequential load
+    std::vector<int> slotOwners[ThingLastCategory];
+    std::vector<Chunk> chunks;
+
+    for (int category = ThingCategoryItem; category < ThingLastCategory; ++category) {
+        const google::protobuf::RepeatedPtrField<appearances::Appearance>* appearances = nullptr;
+        switch (category) {
+            case ThingCategoryItem: appearances = &appearancesLib.object(); break;
+            case ThingCategoryCreature: appearances = &appearancesLib.outfit(); break;
+            case ThingCategoryEffect: appearances = &appearancesLib.effect(); break;
+            case ThingCategoryMissile: appearances = &appearancesLib.missile(); break;
+            default: continue;
+        }
+
+        // fix for custom asserts, where ids are not sorted.
+        uint32_t lastAppearanceId = 0;
+        for (const auto& appearance : *appearances) {
+            if (appearance.id() > lastAppearanceId)
+                lastAppearanceId = appearance.id();
+        }
+
+        auto& things = m_thingTypes[category];
+        things.clear();
+        things.resize(lastAppearanceId + 1, m_nullThingType);
+
+        auto& owners = slotOwners[category];
+        owners.resize(lastAppearanceId + 1, -1);
+        for (int i = -1, s = appearances->size(); ++i < s;)
+            owners[static_cast<uint16_t>((*appearances)[i].id())] = i;
+
+        for (int begin = 0, s = appearances->size(); begin < s; begin += CHUNK_SIZE)
+            chunks.emplace_back(static_cast<ThingCategory>(category), appearances, begin, std::min<int>(begin + CHUNK_SIZE, s));
+    }
+
+    // every chunk writes only into the slots it owns, the vectors are never resized from here on.
+    const auto& unserializeChunk = [&](const Chunk& chunk) {
+        auto& things = m_thingTypes[chunk.category];
+        const auto& owners = slotOwners[chunk.category];
+        for (int i = chunk.begin; i < chunk.end; ++i) {
+            const auto& appearance = (*chunk.appearances)[i];
+            const uint16_t id = appearance.id();
+            if (owners[id] != i)
+                continue;
+
+            const auto& type = std::make_shared<ThingType>();
+            type->unserializeAppearance(id, chunk.category, appearance);
+            things[id] = type;
+        }
+    };
+
+    if (chunks.size() <= 1 || g_asyncDispatcher.get_thread_count() <= 1) {
+        for (const auto& chunk : chunks)
+            unserializeChunk(chunk);
+        return;
+    }
+
+    BS::multi_future<void> tasks;
+    tasks.reserve(chunks.size());
+    for (const auto& chunk : chunks)
+        tasks.emplace_back(g_asyncDispatcher.submit_task([&unserializeChunk, &chunk] { unserializeChunk(chunk); }));
+
+    // let every chunk finish before rethrowing the first worker exception, they reference this frame
+    tasks.wait();
+    tasks.get();
+}
+
 namespace {
     using RaceBank = google::protobuf::RepeatedPtrField<staticdata::Creature>;
 
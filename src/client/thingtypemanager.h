@@ -24,6 +24,8 @@
 
 #include "staticdata.h"
 
+namespace appearances { class Appearances; }
+
 using RaceList = std::vector<RaceType>;
 static const RaceType emptyRaceType{};
 
@@ -79,6 +81,10 @@ public:
     bool isValidDatId(const uint16_t id, const ThingCategory category) const { return category < ThingLastCategory && id >= 1 && id < m_thingTypes[category].size(); }
 
 private:
+    void unserializeAppearances(const appearances::Appearances& appearancesLib);
+    bool loadAppearancesSnapshot(const std::string& file, uint32_t catalogHash);
+    void saveAppearancesSnapshot(const std::string& file, uint32_t catalogHash, const std::string& appearancesFile, uint32_t appearancesHash);
+
     ThingTypeList m_thingTypes[ThingLastCategory];
     RaceList m_monsterRaces;
 
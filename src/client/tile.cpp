@@ -36,7 +36,16 @@
 #include "framework/core/eventdispatcher.h"
 #include "framework/graphics/drawpoolmanager.h"
 
+#include <bit>
+
+struct Tile::DrawCache
+{
+    size_t key{ 0 };
+    DrawPool::DrawCommandList commands;
+};
+
 Tile::Tile(const Position& position) : m_position(position) {}
+Tile::~Tile() = default;
 
 void updateElevation(const ThingPtr& thing, uint8_t& drawElevation) {
     if (thing->hasElevation())
@@ -70,6 +79,64 @@ void Tile::draw(const Point& dest, const int flags, LightView* lightView)
 {
     m_lastDrawDest = dest;
 
+    // the light view is only fed by attached effects here, and tiles with those are never cached
+    size_t drawKey = 0;
+    if (!getDrawCacheKey(flags, drawKey)) {
+        m_drawCache = nullptr;
+        drawThings(dest, flags, lightView);
+        return;
+    }
+
+    // nothing visible changed since the last recording, replay it at the current position
+    // instead of walking the things again, so camera moves keep the cache
+    if (m_drawCache && m_drawCache->key == drawKey) {
+        g_drawPool.replay(m_drawCache->commands, dest);
+        return;
+    }
+
+    if (!m_drawCache)
+        m_drawCache = std::make_unique<DrawCache>();
+
+    g_drawPool.beginCapture(&m_drawCache->commands, dest);
+    drawThings(dest, flags, lightView);
+    m_drawCache->key = g_drawPool.endCapture() ? drawKey : 0;
+}
+
+bool Tile::getDrawCacheKey(const int flags, size_t& key)
+{
+    // creatures, effects and anything time-driven other than item animation phases always record
+    if (m_fill != Color::alpha || m_tilesRedraw || (m_effects && !m_effects->empty()) || hasCreatures() || !m_walkingCreatures.empty()
+        || hasAttachedEffects() || hasAttachedParticles())
+        return false;
+
+    if (const auto& player = g_game.getLocalPlayer(); player && player->getPosition() == m_position)
+        return false;
+
+    key = m_drawVersion;
+    stdext::hash_combine(key, flags);
+    stdext::hash_combine(key, m_drawTopAndCreature);
+    stdext::hash_combine(key, g_drawPool.getScaleFactor());
+    stdext::hash_combine(key, g_drawPool.getOpacity());
+
+    for (const auto& thing : m_things) {
+        if (!thing->isItem() || thing->isMarked() || thing->isHighlighted() || thing->hasShader()
+            || thing->hasAttachedEffects() || thing->hasAttachedParticles() || thing->getScaleFactor() != 1.f)
+            return false;
+
+        const auto& item = thing->static_self_cast<Item>();
+        stdext::hash_combine(key, item->getId());
+        stdext::hash_combine(key, item->getCountOrSubType());
+        stdext::hash_combine(key, item->calculateAnimationPhase());
+        stdext::hash_combine(key, item->canDraw(item->getColor()) && !item->isHided());
+        stdext::hash_combine(key, item->getPatternX() | item->getPatternY() << 8 | item->getPatternZ() << 16);
+        stdext::hash_union(key, item->getColor().hash());
+    }
+
+    return true;
+}
+
+void Tile::drawThings(const Point& dest, const int flags, LightView* lightView)
+{
     uint8_t drawElevation = 0;
 
     if (m_fill != Color::alpha) {
@@ -205,6 +272,9 @@ void Tile::clean()
     while (!m_things.empty())
         removeThing(m_things.front());
 
+    m_drawCache = nullptr;
+    ++m_drawVersion;
+
     m_tilesRedraw = nullptr;
 
     m_thingTypeFlag = 0;
@@ -246,6 +316,8 @@ void Tile::addThing(const ThingPtr& thing, int stackPos)
     if (!thing)
         return;
 
+    ++m_drawVersion;
+
     if (thing->isEffect()) {
         if (!m_effects)
             m_effects = std::make_unique<std::vector<EffectPtr>>();
@@ -329,6 +401,7 @@ void Tile::addThing(const ThingPtr& thing, int stackPos)
 
     updateElevation(thing, m_drawElevation);
     checkForDetachableThing();
+    updateOcclusion();
 
     if (g_game.isTileThingLuaCallbackEnabled())
         callLuaField("onAddThing", thing);
@@ -356,6 +429,7 @@ bool Tile::removeThing(const ThingPtr thing)
     markHighlightedThing(Color::white);
 
     m_things.erase(it);
+    ++m_drawVersion;
 
     m_highlightThingStackPos = -1;
     thing->m_stackPos = -1;
@@ -367,6 +441,7 @@ bool Tile::removeThing(const ThingPtr thing)
 
     updateThingStackPos();
     checkForDetachableThing();
+    updateOcclusion();
 
     if (thing->hasElevation()) {
         m_drawElevation = 0;
@@ -674,60 +749,44 @@ bool Tile::isWalkable(const bool ignoreCreatures)
     return true;
 }
 
-bool Tile::isCompletelyCovered(const uint8_t firstFloor, const bool resetCache)
+bool Tile::isCompletelyCovered(const uint8_t firstFloor)
 {
     if (m_position.z == 0 || m_position.z == firstFloor) return false;
 
-    if (resetCache) {
-        m_isCompletelyCovered = m_isCovered = 0;
-    }
-
     if (hasCreatures() || !m_walkingCreatures.empty() || hasLight())
         return false;
 
-    const uint32_t idChecked = 1 << firstFloor;
-    const uint32_t idState = 1 << (firstFloor + g_gameConfig.getMapMaxZ());
-    if ((m_isCompletelyCovered & idChecked) == 0) {
-        m_isCompletelyCovered |= idChecked;
-        bool isLoading = false;
-        if (g_map.isCompletelyCovered(m_position, isLoading, firstFloor)) {
-            m_isCompletelyCovered |= idState;
-            m_isCovered |= idChecked; // Set covered is Checked
-            m_isCovered |= idState;
-        }
-
-        if (isLoading) {
-            m_isCompletelyCovered &= ~idState;
-            m_isCovered &= ~idChecked;
-            m_isCovered &= ~idState;
-            return false;
-        }
-    }
-
-    return (m_isCompletelyCovered & idState) == idState;
+    return g_map.isCompletelyCovered(m_position, firstFloor);
 }
 
 bool Tile::isCovered(const int8_t firstFloor)
 {
     if (m_position.z == 0 || m_position.z == firstFloor) return false;
 
-    const uint32_t idChecked = 1 << firstFloor;
-    const uint32_t idState = 1 << (firstFloor + g_gameConfig.getMapMaxZ());
+    return g_map.isCovered(m_position, firstFloor);
+}
 
-    if ((m_isCovered & idChecked) == 0) {
-        m_isCovered |= idChecked;
-        bool isLoading = false;
-        if (g_map.isCovered(m_position, isLoading, firstFloor))
-            m_isCovered |= idState;
+void Tile::updateOcclusion()
+{
+    uint8_t occlusion = 0;
+    if (hasTopGround())
+        occlusion |= OCCLUSION_TOP_GROUND;
 
-        if (isLoading) {
-            m_isCovered &= ~idChecked;
-            m_isCovered &= ~idState;
-            return false;
+    if (isFullGround())
+        occlusion |= OCCLUSION_OPAQUE;
+    else {
+        for (const auto& thing : m_things) {
+            if (thing->isOpaque()) {
+                occlusion = (occlusion | OCCLUSION_OPAQUE) & ~OCCLUSION_PENDING;
+                break;
+            }
+
+            if (!thing->isOpacityKnown())
+                occlusion |= OCCLUSION_PENDING;
         }
     }
 
-    return (m_isCovered & idState) == idState;
+    g_map.setTileOcclusion(m_position, occlusion);
 }
 
 bool Tile::isClickable()
@@ -1078,6 +1137,7 @@ int Tile::getTimer()
 void Tile::setFill(Color color)
 {
     m_fill = color;
+    ++m_drawVersion;
 }
 
 bool Tile::canShoot(int distance)
@@ -1090,6 +1150,44 @@ bool Tile::canShoot(int distance)
     return g_map.isSightClear(playerPos, m_position);
 }
 
+namespace
+{
+    // std::vector doubles from one element, so a list that grew to size holds at least the next power of two
+    template<typename T>
+    size_t legacyVectorBytes(const size_t size) { return size == 0 ? 0 : std::bit_ceil(size) * sizeof(T); }
+}
+
+size_t Tile::getMemoryUsage(const bool legacyLayout) const
+{
+    size_t bytes = sizeof(Tile);
+    if (legacyLayout) {
+        bytes = bytes - sizeof(m_things) - sizeof(m_walkingCreatures) + 2 * sizeof(std::vector<ThingPtr>);
+        bytes += legacyVectorBytes<ThingPtr>(m_things.size()) + legacyVectorBytes<CreaturePtr>(m_walkingCreatures.size());
+    } else
+        bytes += m_things.heap_bytes() + m_walkingCreatures.heap_bytes();
+
+    if (m_effects)
+        bytes += sizeof(*m_effects) + m_effects->capacity() * sizeof(EffectPtr);
+    if (m_tilesRedraw)
+        bytes += sizeof(*m_tilesRedraw) + m_tilesRedraw->capacity() * sizeof(TilePtr);
+
+    return bytes;
+}
+
+uint32_t Tile::getHeapBlocks(const bool legacyLayout) const
+{
+    uint32_t blocks = 0;
+    if (m_effects)
+        blocks += 1 + (m_effects->capacity() > 0);
+    if (m_tilesRedraw)
+        blocks += 1 + (m_tilesRedraw->capacity() > 0);
+
+    if (legacyLayout)
+        return blocks + !m_things.empty() + !m_walkingCreatures.empty();
+
+    return blocks + !m_things.is_inline() + !m_walkingCreatures.is_inline();
+}
+
 bool Tile::isFullyOpaque() {
     if (isFullGround())
         return true;
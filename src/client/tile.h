@@ -33,11 +33,13 @@ class Tile final : public AttachableObject
 {
 public:
     Tile(const Position& position);
+    ~Tile() override;
 
     LuaObjectPtr attachedObjectToLuaObject() override { return asLuaObject(); }
     bool isTile() override { return true; }
 
     void onAddInMapView();
+    void updateOcclusion();
     void draw(const Point& dest, int flags, LightView* lightView = nullptr);
     void drawLight(const Point& dest, LightView* lightView);
 
@@ -62,8 +64,8 @@ public:
 
     int getDrawElevation() const { return m_drawElevation; }
     const Position& getPosition() { return m_position; }
-    const std::vector<CreaturePtr>& getWalkingCreatures() { return m_walkingCreatures; }
-    const std::vector<ThingPtr>& getThings() { return m_things; }
+    const stdext::small_vector<CreaturePtr, 1>& getWalkingCreatures() { return m_walkingCreatures; }
+    const stdext::small_vector<ThingPtr, 3>& getThings() { return m_things; }
     std::vector<CreaturePtr> getCreatures();
 
     std::vector<ItemPtr> getItems();
@@ -82,7 +84,7 @@ public:
     bool isEmpty() { return m_things.empty(); }
     bool isDrawable() { return !isEmpty() || !m_walkingCreatures.empty() || hasEffect() || hasAttachedEffects(); }
     bool isCovered(int8_t firstFloor);
-    bool isCompletelyCovered(uint8_t firstFloor, bool resetCache);
+    bool isCompletelyCovered(uint8_t firstFloor);
     bool isLoading() const;
 
     bool hasBlockingCreature() const;
@@ -155,11 +157,19 @@ public:
     void setTimer(int time, Color color);
     int getTimer();
     void setFill(Color color);
-    void resetFill() { m_fill = Color::alpha; }
+    void resetFill() { m_fill = Color::alpha; ++m_drawVersion; }
     bool canShoot(int distance);
 
+    // bytes held by the tile and its thing lists; legacyLayout estimates the same lists as plain std::vector
+    size_t getMemoryUsage(bool legacyLayout = false) const;
+    uint32_t getHeapBlocks(bool legacyLayout = false) const;
+
 private:
+    struct DrawCache;
+
     void updateThingStackPos();
+    void drawThings(const Point& dest, int flags, LightView* lightView);
+    bool getDrawCacheKey(int flags, size_t& key);
     void drawTop(const Point& dest, int flags, bool forceDraw, uint8_t drawElevation);
     void drawCreature(const Point& dest, int flags, bool forceDraw, uint8_t drawElevation, LightView* lightView = nullptr);
 
@@ -179,20 +189,24 @@ private:
     bool hasThingWithElevation() { return hasElevation() && m_thingTypeFlag & HAS_THING_WITH_ELEVATION; }
     void markHighlightedThing(const Color& color);
 
-    std::vector<CreaturePtr> m_walkingCreatures;
-    std::vector<ThingPtr> m_things;
+    // sized for the common case (ground plus a couple of borders or items, rarely a walking creature)
+    // so most tiles never allocate for their lists
+    stdext::small_vector<CreaturePtr, 1> m_walkingCreatures;
+    stdext::small_vector<ThingPtr, 3> m_things;
 
     std::unique_ptr<std::vector<EffectPtr>> m_effects;
     std::unique_ptr<std::vector<TilePtr>> m_tilesRedraw;
 
+    // commands recorded by the last draw of a static tile, replayed while the key matches
+    std::unique_ptr<DrawCache> m_drawCache;
+
     std::unique_ptr<StaticText> m_timerText;
     std::unique_ptr<StaticText> m_text;
     Color m_fill = Color::alpha;
     ticks_t m_timer = 0;
 
-    uint32_t m_isCompletelyCovered{ 0 };
-    uint32_t m_isCovered{ 0 };
     uint32_t m_thingTypeFlag{ 0 };
+    uint32_t m_drawVersion{ 0 };
 
 #ifdef FRAMEWORK_EDITOR
     uint32_t m_houseId{ 0 };
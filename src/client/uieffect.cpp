@@ -62,7 +62,7 @@ void UIEffect::setEffectId(const int id)
         m_effect = nullptr;
     else {
         if (!m_effect)
-            m_effect = std::make_shared<Effect>();
+            m_effect = Effect::create();
         m_effect->setId(id);
         if (m_effect)
             m_effect->setShader(m_shaderName);
@@ -26,6 +26,7 @@
 #include "map.h"
 #include "mapview.h"
 #include "framework/graphics/drawpoolmanager.h"
+#include "framework/graphics/painter.h"
 #include "framework/otml/otmlnode.h"
 #include <framework/platform/platformwindow.h>
 
@@ -79,9 +80,9 @@ void UIMap::drawSelf(const DrawPoolType drawPane)
 
     if (drawPane == DrawPoolType::FOREGROUND) {
         g_drawPool.addBoundingRect(m_mapRect.expanded(1), Color::black);
-        g_drawPool.addAction([] {glDisable(GL_BLEND); });
+        g_drawPool.addAction([] { g_painter->setBlending(false); });
         g_drawPool.addFilledRect(m_mapRect, Color::alpha);
-        g_drawPool.addAction([] {glEnable(GL_BLEND); });
+        g_drawPool.addAction([] { g_painter->setBlending(true); });
     }
 }
 
@@ -63,7 +63,7 @@ void UIMissile::setMissileId(const int id)
         m_missile = nullptr;
     else {
         if (!m_missile)
-            m_missile = std::make_shared<Missile>();
+            m_missile = Missile::create();
         m_missile->setId(id);
         m_missile->setDirection(Otc::South);
 
@@ -25,11 +25,17 @@
 
 bool AdaptativeFrameCounter::update()
 {
+    recordFrame(m_frameTimer.elapsed_micros());
+    m_frameTimer.restart();
+
     const auto maxFps = m_targetFps == 0 ? m_maxFps : std::clamp<uint16_t>(m_targetFps, 1, std::max<uint16_t>(m_maxFps, m_targetFps));
     if (maxFps > 0) {
         const int32_t sleepPeriod = (getMaxPeriod(maxFps) - 1000) - m_timer.elapsed_micros();
-        if (sleepPeriod > 0)
+        if (sleepPeriod > 0) {
+            const stdext::timer sleepTimer;
             stdext::microsleep(std::min<int32_t>(sleepPeriod, DrawPool::FPS1 * 1000));
+            addPhase("limiter", sleepTimer.elapsed_micros());
+        }
     }
 
     m_timer.restart();
@@ -49,3 +55,122 @@ bool AdaptativeFrameCounter::update()
 
     return true;
 }
+
+void AdaptativeFrameCounter::addPhase(const std::string_view name, const uint32_t micros)
+{
+    for (auto& [phaseName, phaseMicros] : m_phases) {
+        if (phaseName == name) {
+            phaseMicros += micros;
+            return;
+        }
+    }
+
+    m_phases.emplace_back(name, micros);
+}
+
+uint32_t AdaptativeFrameCounter::getBucket(const uint32_t micros)
+{
+    const uint32_t millis = micros / 1000;
+    if (millis < FINE_BUCKETS)
+        return millis;
+
+    return std::min<uint32_t>(FINE_BUCKETS + (millis - FINE_BUCKETS) / 10, BUCKETS - 1);
+}
+
+double AdaptativeFrameCounter::getBucketLimit(const uint32_t bucket)
+{
+    if (bucket < FINE_BUCKETS)
+        return bucket + 1;
+
+    return FINE_BUCKETS + (bucket - FINE_BUCKETS + 1) * 10;
+}
+
+void AdaptativeFrameCounter::recordFrame(const uint32_t micros)
+{
+    const ticks_t now = stdext::millis();
+    const bool slow = micros >= m_slowFrameMicros;
+
+    {
+        std::scoped_lock lock(m_statsMutex);
+
+        if (now - m_windowStart >= STATS_WINDOW) {
+            m_currentHistogram ^= 1;
+            m_histograms[m_currentHistogram] = {};
+            m_windowStart = now;
+
+            std::erase_if(m_worstFrames, [now](const SlowFrame& frame) { return now - frame.time >= STATS_WINDOW * 2; });
+        }
+
+        auto& histogram = m_histograms[m_currentHistogram];
+        ++histogram.counts[getBucket(micros)];
+        ++histogram.frames;
+        histogram.maxMicros = std::max<uint32_t>(histogram.maxMicros, micros);
+
+        if (slow) {
+            ++histogram.slowFrames;
+
+            if (m_worstFrames.size() < WORST_FRAMES || micros > m_worstFrames.back().micros) {
+                if (m_worstFrames.size() == WORST_FRAMES)
+                    m_worstFrames.pop_back();
+
+                const auto it = std::upper_bound(m_worstFrames.begin(), m_worstFrames.end(), micros,
+                                                 [](const uint32_t value, const SlowFrame& frame) { return value > frame.micros; });
+                m_worstFrames.insert(it, SlowFrame{ micros, now, m_phases });
+            }
+        }
+    }
+
+    m_phases.clear();
+}
+
+std::map<std::string, double> AdaptativeFrameCounter::getFrameTimeStats() const
+{
+    std::scoped_lock lock(m_statsMutex);
+
+    const auto& current = m_histograms[m_currentHistogram];
+    const auto& previous = m_histograms[m_currentHistogram ^ 1];
+
+    const uint32_t frames = current.frames + previous.frames;
+    const double maxMillis = std::max<uint32_t>(current.maxMicros, previous.maxMicros) / 1000.0;
+
+    std::map<std::string, double> stats;
+    stats["frames"] = frames;
+    stats["slowFrames"] = current.slowFrames + previous.slowFrames;
+    stats["max"] = maxMillis;
+
+    for (const auto& [name, percentile] : { std::pair{ "p50", 0.5 }, std::pair{ "p95", 0.95 }, std::pair{ "p99", 0.99 } }) {
+        // the bucket holding the frame at that rank, reported by its upper limit
+        const auto rank = static_cast<uint32_t>(std::ceil(frames * percentile));
+        uint32_t seen = 0;
+        double value = 0;
+        for (uint32_t bucket = 0; bucket < BUCKETS && rank > 0; ++bucket) {
+            seen += current.counts[bucket] + previous.counts[bucket];
+            if (seen >= rank) {
+                value = std::min(getBucketLimit(bucket), maxMillis);
+                break;
+            }
+        }
+        stats[name] = value;
+    }
+
+    return stats;
+}
+
+std::vector<std::map<std::string, double>> AdaptativeFrameCounter::getWorstFrames() const
+{
+    std::scoped_lock lock(m_statsMutex);
+
+    const ticks_t now = stdext::millis();
+
+    std::vector<std::map<std::string, double>> frames;
+    frames.reserve(m_worstFrames.size());
+    for (const auto& frame : m_worstFrames) {
+        auto& info = frames.emplace_back();
+        info["ms"] = frame.micros / 1000.0;
+        info["age"] = static_cast<double>(now - frame.time);
+        for (const auto& [name, micros] : frame.phases)
+            info[std::string(name)] = micros / 1000.0;
+    }
+
+    return frames;
+}
@@ -24,17 +24,52 @@
 
 #include <framework/global.h>
 
+#include <mutex>
+
  /**
   * Class that help counting and limiting frames per second in a application,
+  * it also keeps frame time histograms and the phases that ran during slow frames.
   */
 class AdaptativeFrameCounter
 {
 public:
-    AdaptativeFrameCounter() : m_interval(stdext::millis()) {}
+    using Phase = std::pair<std::string_view, uint32_t>;
+
+    // a frame that took at least the slow frame threshold, with the phases that ran during it
+    struct SlowFrame
+    {
+        uint32_t micros{ 0 };
+        ticks_t time{ 0 };
+        std::vector<Phase> phases;
+    };
+
+    // times the enclosing scope as a phase of the current frame
+    class ScopedPhase
+    {
+    public:
+        ScopedPhase(AdaptativeFrameCounter& counter, const std::string_view name) : m_counter(counter), m_name(name) {}
+        ~ScopedPhase() { m_counter.addPhase(m_name, m_timer.elapsed_micros()); }
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    private:
+        AdaptativeFrameCounter& m_counter;
+        std::string_view m_name;
+        stdext::timer m_timer;
+    };
 
-    void init() { m_timer.restart(); }
+    AdaptativeFrameCounter() : m_interval(stdext::millis()), m_windowStart(stdext::millis()) {}
+
+    void init() { m_timer.restart(); m_frameTimer.restart(); }
     bool update();
 
+    // the time until the next update isn't a frame, e.g. while the window is hidden
+    void skipFrame() { m_frameTimer.restart(); m_phases.clear(); }
+
+    // names must outlive the counter, phases are only added by the thread calling update()
+    void addPhase(std::string_view name, uint32_t micros);
+
     uint16_t getFps() const { return m_fps; }
     uint16_t getMaxFps() const { return m_maxFps; }
     uint16_t getTargetFps() const { return m_targetFps; }
@@ -44,6 +79,15 @@ public:
 
     void resetTargetFps() { m_targetFps = 0; }
 
+    void setSlowFrameThreshold(const uint16_t millis) { m_slowFrameMicros = millis * 1000u; }
+    uint16_t getSlowFrameThreshold() const { return m_slowFrameMicros / 1000u; }
+
+    // p50, p95, p99 and max frame time in ms over the last 10 to 20 seconds, plus frame counts
+    std::map<std::string, double> getFrameTimeStats() const;
+
+    // slowest recent frames, longest first: "ms", "age" in ms and the time of each phase in ms
+    std::vector<std::map<std::string, double>> getWorstFrames() const;
+
     float getPercent() const {
         const float maxFps = std::clamp<uint16_t>(m_targetFps, 1, std::max<uint16_t>(m_maxFps, m_targetFps));
         return ((maxFps - m_fps) / maxFps) * 100.f;
@@ -54,7 +98,27 @@ public:
     }
 
 private:
+    static constexpr ticks_t STATS_WINDOW = 10000;
+    static constexpr size_t WORST_FRAMES = 8;
+
+    // 1 ms buckets up to 100 ms, 10 ms buckets up to 1 s and one for anything slower
+    static constexpr uint32_t FINE_BUCKETS = 100;
+    static constexpr uint32_t COARSE_BUCKETS = 90;
+    static constexpr uint32_t BUCKETS = FINE_BUCKETS + COARSE_BUCKETS + 1;
+
+    struct Histogram
+    {
+        std::array<uint32_t, BUCKETS> counts{};
+        uint32_t frames{ 0 };
+        uint32_t slowFrames{ 0 };
+        uint32_t maxMicros{ 0 };
+    };
+
+    static uint32_t getBucket(uint32_t micros);
+    static double getBucketLimit(uint32_t bucket);
+
     uint32_t getMaxPeriod(const uint16_t fps) const { return 1000000u / fps; }
+    void recordFrame(uint32_t micros);
 
     uint16_t m_maxFps{};
     uint16_t m_targetFps{ 60u };
@@ -63,6 +127,17 @@ private:
     uint16_t m_fpsCount{};
 
     uint32_t m_interval{};
+    uint32_t m_slowFrameMicros{ 50000 };
 
     stdext::timer m_timer;
+    stdext::timer m_frameTimer;
+
+    std::vector<Phase> m_phases;
+
+    // previous and current window, read from other threads through the stats getters
+    Histogram m_histograms[2];
+    uint8_t m_currentHistogram{ 0 };
+    ticks_t m_windowStart{};
+    std::vector<SlowFrame> m_worstFrames;
+    mutable std::mutex m_statsMutex;
 };
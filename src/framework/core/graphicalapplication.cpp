@@ -46,6 +46,12 @@
 
 GraphicalApplication g_app;
 
+// frame phase names of each pool, indexed by DrawPoolType
+static constexpr std::string_view DRAW_PHASES[] = { "draw.map", "draw.creatureInformation", "draw.light", "draw.foregroundMap", "draw.foreground" };
+static constexpr std::string_view RECORD_PHASES[] = { "record.map", "record.creatureInformation", "record.light", "record.foregroundMap", "record.foreground" };
+static_assert(std::size(DRAW_PHASES) == static_cast<size_t>(DrawPoolType::LAST));
+static_assert(std::size(RECORD_PHASES) == static_cast<size_t>(DrawPoolType::LAST));
+
 void GraphicalApplication::init(std::vector<std::string>& args, ApplicationContext* context)
 {
     Application::init(args, context);
@@ -53,7 +59,12 @@ void GraphicalApplication::init(std::vector<std::string>& args, ApplicationConte
     auto graphicalContext = static_cast<GraphicalApplicationContext*>(context);
     setDrawEvents(graphicalContext->getDrawEvents());
 
+    // -headless runs without a native window and GL context, the null painter
+    // still drives the whole render path (CPU-side benchmarking, no display needed)
+    const bool headless = getStartupOptions().find("-headless") != std::string::npos;
+
     // setup platform window
+    g_window.setHeadless(headless);
     g_window.init();
     g_window.hide();
 
@@ -78,6 +89,7 @@ void GraphicalApplication::init(std::vector<std::string>& args, ApplicationConte
     g_ui.init();
 
     // initialize graphics
+    g_graphics.setHeadless(headless);
     g_graphics.init();
     g_drawPool.init(graphicalContext->getSpriteSize());
 
@@ -138,6 +150,7 @@ void GraphicalApplication::mainLoop() {
     mainPoll();
 
     if (!g_window.isVisible()) {
+        m_graphicFrameCounter.skipFrame();
         stdext::millisleep(10);
         return;
     }
@@ -147,7 +160,7 @@ void GraphicalApplication::mainLoop() {
         return m_graphicFrameCounter.getFps();
     };
 
-    g_drawPool.draw();
+    drawFrame();
 
     if (m_graphicFrameCounter.update()) {
         g_dispatcher.addEvent([this, fps = FPS()] {
@@ -187,29 +200,52 @@ void GraphicalApplication::run()
             poll();
 
             if (!g_window.isVisible()) {
+                m_mapProcessFrameCounter.skipFrame();
                 stdext::millisleep(10);
                 continue;
             }
 
+            // no recording is in flight here, atlas regions can move
+            g_drawPool.applyAtlasCompactions();
+
             if (m_drawEvents->canDraw(DrawPoolType::MAP)) {
                 if (g_drawPool.isDrawing())
                     continue;
 
-                m_drawEvents->preLoad();
+                {
+                    const AdaptativeFrameCounter::ScopedPhase phase(m_mapProcessFrameCounter, "preLoad");
+                    m_drawEvents->preLoad();
+                }
 
+                // each task writes its own slot, read once all of them are done
+                std::array<uint32_t, static_cast<uint8_t>(DrawPoolType::LAST)> recordDurations{};
                 for (const auto type : { DrawPoolType::LIGHT , DrawPoolType::FOREGROUND, DrawPoolType::FOREGROUND_MAP }) {
                     if (m_drawEvents->canDraw(type)) {
-                        tasks.emplace_back(g_asyncDispatcher.submit_task([this, type] {
+                        tasks.emplace_back(g_asyncDispatcher.submit_task([this, type, &recordDurations] {
+                            const stdext::timer timer;
                             m_drawEvents->draw(type);
+                            recordDurations[static_cast<uint8_t>(type)] = timer.elapsed_micros();
                         }));
                     }
                 }
 
-                m_drawEvents->draw(DrawPoolType::MAP);
+                {
+                    const AdaptativeFrameCounter::ScopedPhase phase(m_mapProcessFrameCounter, RECORD_PHASES[static_cast<uint8_t>(DrawPoolType::MAP)]);
+                    m_drawEvents->draw(DrawPoolType::MAP);
+                }
 
-                tasks.wait();
+                {
+                    const AdaptativeFrameCounter::ScopedPhase phase(m_mapProcessFrameCounter, "wait");
+                    tasks.wait();
+                }
                 tasks.clear();
+
+                for (size_t i = 0; i < recordDurations.size(); ++i) {
+                    if (recordDurations[i] > 0)
+                        m_mapProcessFrameCounter.addPhase(RECORD_PHASES[i], recordDurations[i]);
+                }
             } else if (m_drawEvents->canDraw(DrawPoolType::FOREGROUND)) {
+                const AdaptativeFrameCounter::ScopedPhase phase(m_mapProcessFrameCounter, RECORD_PHASES[static_cast<uint8_t>(DrawPoolType::FOREGROUND)]);
                 g_ui.render(DrawPoolType::FOREGROUND);
             }
 
@@ -226,14 +262,18 @@ void GraphicalApplication::run()
         mainPoll();
 
         if (!g_window.isVisible()) {
+            m_graphicFrameCounter.skipFrame();
             stdext::millisleep(10);
             continue;
         }
 
-        g_drawPool.draw();
+        drawFrame();
 
         // update screen pixels
-        g_window.swapBuffers();
+        if (!g_graphics.isHeadless()) {
+            const AdaptativeFrameCounter::ScopedPhase phase(m_graphicFrameCounter, "swap");
+            g_window.swapBuffers();
+        }
 
         if (m_graphicFrameCounter.update()) {
             g_dispatcher.addEvent([this, fps = FPS()] {
@@ -252,15 +292,24 @@ void GraphicalApplication::run()
 
 void GraphicalApplication::poll()
 {
-    GarbageCollection::poll();
+    {
+        const AdaptativeFrameCounter::ScopedPhase phase(m_mapProcessFrameCounter, "gc");
+        GarbageCollection::poll();
+    }
 
-    Application::poll();
+    {
+        const AdaptativeFrameCounter::ScopedPhase phase(m_mapProcessFrameCounter, "dispatcher");
+        Application::poll();
+    }
 
 #ifdef FRAMEWORK_SOUND
     g_sounds.poll();
 #endif
 
-    g_particles.poll();
+    {
+        const AdaptativeFrameCounter::ScopedPhase phase(m_mapProcessFrameCounter, "particles");
+        g_particles.poll();
+    }
 
     if (!g_window.isVisible()) {
         g_textDispatcher.poll();
@@ -269,9 +318,31 @@ void GraphicalApplication::poll()
 void GraphicalApplication::mainPoll()
 {
     g_clock.update();
-    g_mainDispatcher.poll();
-    g_window.poll();
-    g_textures.poll();
+
+    {
+        const AdaptativeFrameCounter::ScopedPhase phase(m_graphicFrameCounter, "mainDispatcher");
+        g_mainDispatcher.poll();
+    }
+
+    {
+        const AdaptativeFrameCounter::ScopedPhase phase(m_graphicFrameCounter, "window");
+        g_window.poll();
+    }
+
+    {
+        const AdaptativeFrameCounter::ScopedPhase phase(m_graphicFrameCounter, "textures");
+        g_textures.poll();
+    }
+}
+
+void GraphicalApplication::drawFrame()
+{
+    g_drawPool.draw();
+
+    for (uint8_t i = 0; i < static_cast<uint8_t>(DrawPoolType::LAST); ++i) {
+        if (const auto duration = g_drawPool.getDrawDuration(static_cast<DrawPoolType>(i)))
+            m_graphicFrameCounter.addPhase(DRAW_PHASES[i], duration);
+    }
 }
 
 void GraphicalApplication::close()
@@ -319,6 +390,9 @@ void GraphicalApplication::setLoadingAsyncTexture(bool v) {
 
 void GraphicalApplication::doScreenshot(std::string file)
 {
+    if (g_graphics.isHeadless())
+        return;
+
     if (file.empty()) {
         file = "screenshot.png";
     }
@@ -85,6 +85,15 @@ public:
 
     void resetTargetFps() { m_graphicFrameCounter.resetTargetFps(); }
 
+    // frame time percentiles and slowest frames of the render loop, or of the map & pool thread
+    std::map<std::string, double> getFrameTimeStats(const bool mapThread) const { return getFrameCounter(mapThread).getFrameTimeStats(); }
+    std::vector<std::map<std::string, double>> getWorstFrames(const bool mapThread) const { return getFrameCounter(mapThread).getWorstFrames(); }
+    uint16_t getSlowFrameThreshold() const { return m_graphicFrameCounter.getSlowFrameThreshold(); }
+    void setSlowFrameThreshold(const uint16_t millis) {
+        m_graphicFrameCounter.setSlowFrameThreshold(millis);
+        m_mapProcessFrameCounter.setSlowFrameThreshold(millis);
+    }
+
     bool isOnInputEvent() { return m_onInputEvent; }
     bool mustOptimize() {
 #ifdef NDEBUG
@@ -140,6 +149,9 @@ protected:
     void inputEvent(const InputEvent& event);
 
 private:
+    const AdaptativeFrameCounter& getFrameCounter(const bool mapThread) const { return mapThread ? m_mapProcessFrameCounter : m_graphicFrameCounter; }
+    void drawFrame();
+
     bool m_onInputEvent{ false };
     bool m_optimize{ true };
     bool m_forceEffectOptimization{ true };
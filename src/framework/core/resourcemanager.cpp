@@ -495,6 +495,15 @@ ticks_t ResourceManager::getFileTime(const std::string& filename)
     return g_platform.getFileModificationTime(getRealPath(filename));
 }
 
+int64_t ResourceManager::getFileSize(const std::string& fileName)
+{
+    PHYSFS_Stat stat = {};
+    if (!PHYSFS_stat(resolvePath(fileName).c_str(), &stat))
+        return -1;
+
+    return stat.filesize;
+}
+
 std::string ResourceManager::encrypt(const std::string& data, const std::string& password)
 {
     const int len = data.length(),
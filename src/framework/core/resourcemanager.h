@@ -76,6 +76,7 @@ public:
     bool isFileType(const std::string& filename, const std::string& type);
     std::string getFileName(const std::string& filePath);
     ticks_t getFileTime(const std::string& filename);
+    int64_t getFileSize(const std::string& fileName);
 
     std::string encrypt(const std::string& data, const std::string& password);
     std::string decrypt(const std::string& data);
@@ -23,8 +23,19 @@
 #include "animatedtexture.h"
 
 #include "drawpoolmanager.h"
+#include "image.h"
+#include "framework/core/asyncdispatcher.h"
 #include "framework/core/eventdispatcher.h"
 
+static ImagePtr decodeStreamFrame(const Size& size, const uint8_t bpp, const std::vector<uint8_t>& data)
+{
+    const auto& image = std::make_shared<Image>(size, bpp);
+    uLongf length = image->getPixels().size();
+    if (uncompress(image->getPixelData(), &length, data.data(), data.size()) != Z_OK || length != image->getPixels().size())
+        return nullptr;
+    return image;
+}
+
 AnimatedTexture::AnimatedTexture(const Size& size, const std::vector<ImagePtr>& frames, std::vector<uint16_t> framesDelay, const uint16_t numPlays, bool buildMipmaps, bool compress)
 {
     if (!setupSize(size))
@@ -41,6 +52,115 @@ AnimatedTexture::AnimatedTexture(const Size& size, const std::vector<ImagePtr>&
     m_animTimer.restart();
 }
 
+AnimatedTexture::AnimatedTexture(const Size& size, const uint8_t bpp, std::vector<std::vector<uint8_t>> compressedFrames, std::vector<uint16_t> framesDelay, const uint16_t numPlays, const uint8_t ringSize)
+{
+    if (!setupSize(size))
+        return;
+
+    m_stream = std::make_shared<Stream>();
+    m_stream->size = size;
+    m_stream->bpp = bpp;
+    m_stream->frames = std::move(compressedFrames);
+
+    m_ringSize = std::max<uint8_t>(ringSize, 2);
+    m_framesDelay = std::move(framesDelay);
+    m_numPlays = numPlays;
+
+    // the first frame is decoded right away so there is always something to show
+    if (const auto& image = decodeStreamFrame(size, bpp, m_stream->frames[0])) {
+        m_currentTexture = std::make_shared<Texture>(image, false, false);
+        m_ring.emplace_back(0, m_currentTexture);
+        s_streamingMemoryUsage += getFrameBytes();
+    } else
+        m_currentTexture = std::make_shared<Texture>();
+
+    m_animTimer.restart();
+}
+
+AnimatedTexture::~AnimatedTexture()
+{
+    if (m_stream)
+        s_streamingMemoryUsage -= m_ring.size() * getFrameBytes();
+}
+
+uint32_t AnimatedTexture::getWantedFrames() const
+{
+    // once the global budget is used up each animation only looks one frame ahead
+    if (getStreamingMemoryUsage() >= getStreamingMemoryLimit())
+        return 2;
+    return std::min<uint32_t>(m_ringSize, getFramesCount());
+}
+
+bool AnimatedTexture::isWanted(const uint32_t frame) const
+{
+    const uint32_t count = getFramesCount();
+    return (frame + count - m_currentFrame) % count < getWantedFrames();
+}
+
+TexturePtr AnimatedTexture::getRingFrame(const uint32_t frame) const
+{
+    for (const auto& [index, texture] : m_ring) {
+        if (index == frame)
+            return texture;
+    }
+    return nullptr;
+}
+
+void AnimatedTexture::prefetch()
+{
+    if (!m_stream || !m_animTimer.running())
+        return;
+
+    const uint32_t count = getFramesCount();
+    const uint32_t wanted = getWantedFrames();
+
+    std::scoped_lock l(m_stream->mutex);
+    for (uint32_t i = 0; i < wanted; ++i) {
+        const uint32_t frame = (m_currentFrame + i) % count;
+        if (getRingFrame(frame) || std::ranges::find(m_stream->pending, frame) != m_stream->pending.end()
+            || std::ranges::find(m_stream->decoded, frame, &std::pair<uint32_t, ImagePtr>::first) != m_stream->decoded.end())
+            continue;
+
+        m_stream->pending.emplace_back(frame);
+        g_asyncDispatcher.detach_task([stream = m_stream, frame] {
+            const auto& image = decodeStreamFrame(stream->size, stream->bpp, stream->frames[frame]);
+
+            std::scoped_lock l(stream->mutex);
+            std::erase(stream->pending, frame);
+            if (image)
+                stream->decoded.emplace_back(frame, image);
+        });
+    }
+}
+
+void AnimatedTexture::adoptDecodedFrames()
+{
+    const size_t frameBytes = getFrameBytes();
+
+    // drop frames that playback already left behind, the one on screen stays referenced by m_currentTexture
+    std::erase_if(m_ring, [&](const auto& entry) {
+        if (isWanted(entry.first))
+            return false;
+        s_streamingMemoryUsage -= frameBytes;
+        return true;
+    });
+
+    for (auto& [frame, image] : m_stream->decoded) {
+        if (!isWanted(frame) || getRingFrame(frame))
+            continue;
+
+        const auto& texture = std::make_shared<Texture>(image, false, false);
+        texture->setSmooth(isSmooth());
+        texture->setRepeat(hasRepeat());
+        m_ring.emplace_back(frame, texture);
+        s_streamingMemoryUsage += frameBytes;
+    }
+    m_stream->decoded.clear();
+
+    if (const auto& texture = getRingFrame(m_currentFrame))
+        m_currentTexture = texture;
+}
+
 void AnimatedTexture::buildHardwareMipmaps()
 {
     if (getProp(hasMipMaps)) return;
@@ -49,6 +169,8 @@ void AnimatedTexture::buildHardwareMipmaps()
     g_mainDispatcher.addEvent([this] {
         for (const auto& frame : m_frames)
             frame->buildHardwareMipmaps();
+        if (m_currentTexture)
+            m_currentTexture->buildHardwareMipmaps();
     });
 }
 
@@ -58,6 +180,11 @@ void AnimatedTexture::setSmooth(bool smooth)
     g_mainDispatcher.addEvent([this, smooth] {
         for (const auto& frame : m_frames)
             frame->setSmooth(smooth);
+        if (m_stream) {
+            std::scoped_lock l(m_stream->mutex);
+            for (const auto& [index, frame] : m_ring)
+                frame->setSmooth(smooth);
+        }
     });
 }
 
@@ -67,10 +194,21 @@ void AnimatedTexture::setRepeat(bool repeat)
     g_mainDispatcher.addEvent([this, repeat] {
         for (const auto& frame : m_frames)
             frame->setRepeat(repeat);
+        if (m_stream) {
+            std::scoped_lock l(m_stream->mutex);
+            for (const auto& [index, frame] : m_ring)
+                frame->setRepeat(repeat);
+        }
     });
 }
 
 TexturePtr AnimatedTexture::get(uint32_t& frame, Timer& timer) {
+    // only the frames around the shared playback are resident when streaming
+    if (m_stream) {
+        frame = m_currentFrame;
+        return m_currentTexture;
+    }
+
     if (timer.ticksElapsed() >= m_framesDelay[frame]) {
         timer.restart();
 
@@ -83,7 +221,7 @@ TexturePtr AnimatedTexture::get(uint32_t& frame, Timer& timer) {
 }
 
 TexturePtr AnimatedTexture::getCurrentFrame() {
-    return m_frames[m_currentFrame];
+    return m_stream ? m_currentTexture : m_frames[m_currentFrame];
 }
 
 void AnimatedTexture::allowAtlasCache() {
@@ -92,6 +230,15 @@ void AnimatedTexture::allowAtlasCache() {
 }
 
 void AnimatedTexture::create() {
+    if (m_stream) {
+        std::scoped_lock l(m_stream->mutex);
+        for (const auto& [index, frame] : m_ring)
+            frame->create();
+        m_currentTexture->create();
+        m_id = m_currentTexture->getId();
+        return;
+    }
+
     if (getCurrentFrame()->isEmpty()) {
         for (const auto& frame : m_frames)
             frame->create();
@@ -103,13 +250,28 @@ void AnimatedTexture::update()
     if (!m_animTimer.running())
         return;
 
+    if (m_stream) {
+        std::scoped_lock l(m_stream->mutex);
+        adoptDecodedFrames();
+    }
+
     if (!isEmpty()) {
         if (m_animTimer.ticksElapsed() < m_framesDelay[m_currentFrame])
             return;
 
+        const uint32_t nextFrame = (m_currentFrame + 1) % getFramesCount();
+        if (m_stream) {
+            // hold the current frame until the next one has been decoded
+            std::scoped_lock l(m_stream->mutex);
+            const auto& texture = getRingFrame(nextFrame);
+            if (!texture)
+                return;
+            m_currentTexture = texture;
+        }
+
         m_animTimer.restart(); // it is necessary to restart the animation before stop()
 
-        if (++m_currentFrame >= m_frames.size()) {
+        if (++m_currentFrame >= getFramesCount()) {
             m_currentFrame = 0;
             if (m_numPlays > 0 && ++m_currentPlay == m_numPlays)
                 m_animTimer.stop();
@@ -28,7 +28,9 @@ class AnimatedTexture final : public Texture
 {
 public:
     AnimatedTexture(const Size& size, const std::vector<ImagePtr>& frames, std::vector<uint16_t> framesDelay, uint16_t numPlays, bool buildMipmaps = false, bool compress = false);
-    ~AnimatedTexture() override = default;
+    // streaming animation: frames are kept zlib compressed and decoded shortly before they are shown
+    AnimatedTexture(const Size& size, uint8_t bpp, std::vector<std::vector<uint8_t>> compressedFrames, std::vector<uint16_t> framesDelay, uint16_t numPlays, uint8_t ringSize);
+    ~AnimatedTexture() override;
 
     TexturePtr get(uint32_t& frame, Timer& timer);
     TexturePtr getCurrentFrame();
@@ -46,6 +48,8 @@ public:
     void setOnMap(const bool v) { m_onMap = v; }
 
     void update();
+    // queues the decoding of the frames about to be shown, streaming animations only
+    void prefetch();
     void restart() { m_animTimer.restart(); m_currentPlay = 0; m_currentFrame = 0; }
 
     bool isAnimatedTexture() const override { return true; }
@@ -53,10 +57,44 @@ public:
 
     void allowAtlasCache() override;
 
+    bool isStreaming() const { return m_stream != nullptr; }
+    uint32_t getFramesCount() const { return m_framesDelay.size(); }
+
+    // decoded bytes held by every streaming animation
+    static size_t getStreamingMemoryUsage() { return s_streamingMemoryUsage.load(std::memory_order_relaxed); }
+    static void setStreamingMemoryLimit(const size_t bytes) { s_streamingMemoryLimit.store(bytes, std::memory_order_relaxed); }
+    static size_t getStreamingMemoryLimit() { return s_streamingMemoryLimit.load(std::memory_order_relaxed); }
+
 private:
+    struct Stream
+    {
+        Size size;
+        uint8_t bpp{ 4 };
+        std::vector<std::vector<uint8_t>> frames;
+
+        std::mutex mutex;
+        std::vector<std::pair<uint32_t, ImagePtr>> decoded; // decoded by a worker, waiting to join the ring
+        std::vector<uint32_t> pending;
+    };
+
+    size_t getFrameBytes() const { return static_cast<size_t>(m_stream->size.area()) * m_stream->bpp; }
+    uint32_t getWantedFrames() const;
+    bool isWanted(uint32_t frame) const;
+    TexturePtr getRingFrame(uint32_t frame) const;
+    void adoptDecodedFrames();
+
     std::vector<TexturePtr> m_frames;
     std::vector<uint16_t> m_framesDelay;
 
+    // streaming state, the ring holds the few textures around the current frame
+    std::shared_ptr<Stream> m_stream;
+    std::vector<std::pair<uint32_t, TexturePtr>> m_ring;
+    TexturePtr m_currentTexture;
+    uint8_t m_ringSize{ 0 };
+
+    inline static std::atomic<size_t> s_streamingMemoryUsage{ 0 };
+    inline static std::atomic<size_t> s_streamingMemoryLimit{ 64 * 1024 * 1024 };
+
     bool m_onMap{ false };
 
     uint32_t m_currentFrame{ 0 };
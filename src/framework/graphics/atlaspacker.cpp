@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "atlaspacker.h"
+
+#include <algorithm>
+#include <numeric>
+
+int AtlasPacker::addLayer()
+{
+    const int layer = getLayerCount();
+    m_layerUsedArea.emplace_back(0);
+    insertFreeRegion({ 0, 0, m_width, m_height, layer });
+    return layer;
+}
+
+std::optional<FreeRegion> AtlasPacker::allocate(const int width, const int height)
+{
+    if (width <= 0 || height <= 0)
+        return std::nullopt;
+
+    for (auto sizeIt = m_freeRegionsBySize.lower_bound(width * height); sizeIt != m_freeRegionsBySize.end(); ++sizeIt) {
+        const auto it = std::ranges::find_if(sizeIt->second, [&](const FreeRegion& region) { return region.canFit(width, height); });
+        if (it == sizeIt->second.end())
+            continue;
+
+        const FreeRegion region = *it;
+        eraseFreeRegion(region);
+
+        // guillotine cut along the axis that keeps the bigger leftover in one piece
+        const int rightWidth = region.width - width;
+        const int bottomHeight = region.height - height;
+        if (static_cast<int64_t>(rightWidth) * region.height >= static_cast<int64_t>(region.width) * bottomHeight) {
+            insertFreeRegion({ region.x + width, region.y, rightWidth, region.height, region.layer });
+            insertFreeRegion({ region.x, region.y + height, width, bottomHeight, region.layer });
+        } else {
+            insertFreeRegion({ region.x + width, region.y, rightWidth, height, region.layer });
+            insertFreeRegion({ region.x, region.y + height, region.width, bottomHeight, region.layer });
+        }
+
+        m_layerUsedArea[region.layer] += static_cast<int64_t>(width) * height;
+        return FreeRegion{ region.x, region.y, width, height, region.layer };
+    }
+
+    return std::nullopt;
+}
+
+void AtlasPacker::release(const FreeRegion& region)
+{
+    if (region.layer < 0 || region.layer >= getLayerCount() || region.width <= 0 || region.height <= 0)
+        return;
+
+    m_layerUsedArea[region.layer] -= static_cast<int64_t>(region.width) * region.height;
+
+    const auto sharesEdge = [](const FreeRegion& a, const FreeRegion& b) {
+        if (a.y == b.y && a.height == b.height)
+            return a.x + a.width == b.x || b.x + b.width == a.x;
+        if (a.x == b.x && a.width == b.width)
+            return a.y + a.height == b.y || b.y + b.height == a.y;
+        return false;
+    };
+
+    // keep merging while a free neighbour of the same layer lines up with a whole edge
+    FreeRegion merged = region;
+    for (bool found = true; found;) {
+        found = false;
+        for (auto it = m_freeRegions.lower_bound({ 0, 0, 0, 0, merged.layer }); it != m_freeRegions.end() && it->layer == merged.layer; ++it) {
+            if (!sharesEdge(merged, *it))
+                continue;
+
+            const FreeRegion other = *it;
+            eraseFreeRegion(other);
+
+            const int x = std::min(merged.x, other.x);
+            const int y = std::min(merged.y, other.y);
+            merged = { x, y, std::max(merged.x + merged.width, other.x + other.width) - x,
+                       std::max(merged.y + merged.height, other.y + other.height) - y, merged.layer };
+            found = true;
+            break;
+        }
+    }
+
+    insertFreeRegion(merged);
+}
+
+void AtlasPacker::clear()
+{
+    m_layerUsedArea.clear();
+    m_freeRegions.clear();
+    m_freeRegionsBySize.clear();
+}
+
+std::optional<std::vector<FreeRegion>> AtlasPacker::pack(const std::vector<std::pair<int, int>>& sizes)
+{
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&](const size_t a, const size_t b) {
+        if (sizes[a].second != sizes[b].second)
+            return sizes[a].second > sizes[b].second;
+        return sizes[a].first > sizes[b].first;
+    });
+
+    std::vector<FreeRegion> regions(sizes.size());
+    for (const auto i : order) {
+        const auto [width, height] = sizes[i];
+
+        auto region = allocate(width, height);
+        if (!region) {
+            addLayer();
+            region = allocate(width, height);
+        }
+
+        if (!region)
+            return std::nullopt;
+
+        regions[i] = *region;
+    }
+
+    return regions;
+}
+
+AtlasPacker::Stats AtlasPacker::getStats() const
+{
+    Stats stats;
+    stats.layers = getLayerCount();
+    stats.freeRegions = static_cast<int>(m_freeRegions.size());
+    stats.totalArea = getLayerArea() * stats.layers;
+    stats.usedArea = std::accumulate(m_layerUsedArea.begin(), m_layerUsedArea.end(), int64_t{ 0 });
+    stats.largestFreeArea = m_freeRegionsBySize.empty() ? 0 : m_freeRegionsBySize.rbegin()->first;
+    stats.layerUsedArea = m_layerUsedArea;
+    return stats;
+}
+
+void AtlasPacker::insertFreeRegion(const FreeRegion& region)
+{
+    if (region.width <= 0 || region.height <= 0)
+        return;
+
+    m_freeRegions.insert(region);
+    m_freeRegionsBySize[region.width * region.height].insert(region);
+}
+
+void AtlasPacker::eraseFreeRegion(const FreeRegion& region)
+{
+    m_freeRegions.erase(region);
+
+    const auto it = m_freeRegionsBySize.find(region.width * region.height);
+    if (it == m_freeRegionsBySize.end())
+        return;
+
+    it->second.erase(region);
+    if (it->second.empty())
+        m_freeRegionsBySize.erase(it);
+}
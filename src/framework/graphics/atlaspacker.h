@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+struct FreeRegion
+{
+    int x, y, width, height, layer;
+
+    bool operator<(const FreeRegion& other) const {
+        if (layer != other.layer) return layer < other.layer;
+        if (width * height != other.width * other.height)
+            return (width * height) < (other.width * other.height);
+        return (y != other.y) ? (y < other.y) : (x < other.x);
+    }
+
+    bool operator==(const FreeRegion& other) const = default;
+
+    bool canFit(int texWidth, int texHeight) const {
+        return width >= texWidth && height >= texHeight;
+    }
+};
+
+// Guillotine packer for the layers of a texture atlas, free of any GL state.
+// Released regions are merged back with free neighbours sharing a whole edge,
+// so space freed over time can be handed out again to textures of any size.
+class AtlasPacker
+{
+public:
+    struct Stats
+    {
+        int layers{ 0 };
+        int freeRegions{ 0 };
+        int64_t totalArea{ 0 };
+        int64_t usedArea{ 0 };
+        int64_t largestFreeArea{ 0 };
+        std::vector<int64_t> layerUsedArea;
+
+        float occupancy() const { return totalArea > 0 ? static_cast<float>(usedArea) / totalArea : 0.f; }
+
+        // share of the free space outside of the largest free region
+        float fragmentation() const {
+            const auto freeArea = totalArea - usedArea;
+            return freeArea > 0 ? 1.f - static_cast<float>(largestFreeArea) / freeArea : 0.f;
+        }
+    };
+
+    AtlasPacker(const int width, const int height) : m_width(width), m_height(height) {}
+
+    int addLayer();
+    std::optional<FreeRegion> allocate(int width, int height);
+    void release(const FreeRegion& region);
+    void clear();
+
+    // packs the sizes into new layers, tallest first, and returns their regions in input order
+    std::optional<std::vector<FreeRegion>> pack(const std::vector<std::pair<int, int>>& sizes);
+
+    int getLayerCount() const { return static_cast<int>(m_layerUsedArea.size()); }
+    int64_t getLayerArea() const { return static_cast<int64_t>(m_width) * m_height; }
+    Stats getStats() const;
+
+private:
+    void insertFreeRegion(const FreeRegion& region);
+    void eraseFreeRegion(const FreeRegion& region);
+
+    int m_width;
+    int m_height;
+
+    std::vector<int64_t> m_layerUsedArea;
+    std::set<FreeRegion> m_freeRegions;
+    std::map<int, std::set<FreeRegion>> m_freeRegionsBySize;
+};
@@ -23,6 +23,7 @@
 #include "bitmapfont.h"
 
 #include "drawpoolmanager.h"
+#include "fontmanager.h"
 #include "image.h"
 #include "painter.h"
 #include "texture.h"
@@ -74,22 +75,47 @@ void BitmapFont::load(const OTMLNodePtr& fontNode)
 
 void BitmapFont::drawText(const std::string_view text, const Point& startPos, const Color& color)
 {
-    const Size boxSize = g_painter->getResolution() - startPos.toSize();
-    const Rect screenCoords(startPos, boxSize);
-    drawText(text, screenCoords, color, Fw::AlignTopLeft);
+    // top left aligned text is only clipped by the screen, so the glyphs are drawn from the
+    // cached positions at startPos instead of laying the text out for every position
+    if (!m_texture)
+        return;
+
+    calculateGlyphsPositions(text, Fw::AlignTopLeft, s_glyphsPositions, nullptr);
+
+    for (int i = 0, s = static_cast<int>(text.size()); i < s; ++i) {
+        const int glyph = static_cast<uint8_t>(text[i]);
+        if (glyph < 32) continue;
+
+        g_drawPool.addTexturedRect(Rect(startPos + s_glyphsPositions[i], m_glyphsSize[glyph]), m_texture, m_glyphsTextureCoords[glyph], color);
+    }
 }
 
 void BitmapFont::drawText(const std::string_view text, const Rect& screenCoords, const Color& color, const Fw::AlignmentFlag align)
 {
-    Size textBoxSize;
-    calculateGlyphsPositions(text, align, s_glyphsPositions, &textBoxSize);
+    const Size boxSize = screenCoords.size();
+
+    auto layout = g_fonts.getTextLayout(this, text, align, boxSize);
+    if (!layout) {
+        auto newLayout = std::make_shared<FontManager::TextLayout>();
+        layoutGlyphs(text, align, s_glyphsPositions, newLayout->textBoxSize);
+        newLayout->coords = getRelativeTextCoords(text, newLayout->textBoxSize, align, boxSize, s_glyphsPositions);
+        g_fonts.cacheTextLayout(this, text, align, boxSize, newLayout);
+        layout = std::move(newLayout);
+    }
 
-    auto pairs = getDrawTextCoords(text, textBoxSize, align, screenCoords, s_glyphsPositions);
-    for (const auto& p : pairs) {
-        g_drawPool.addTexturedRect(p.first, m_texture, p.second, color);
+    for (const auto& [glyphScreenCoords, glyphTextureCoords] : layout->coords) {
+        g_drawPool.addTexturedRect(glyphScreenCoords.translated(screenCoords.topLeft()), m_texture, glyphTextureCoords, color);
     }
 }
 
+std::vector<std::pair<Rect, Rect>> BitmapFont::getRelativeTextCoords(const std::string_view text, const Size& textBoxSize,
+                                                                     const Fw::AlignmentFlag align, const Size& boxSize,
+                                                                     const std::vector<Point>& glyphsPositions) const noexcept
+{
+    // clipping only depends on the box size, so glyphs laid out at the origin can be translated to any position
+    return getDrawTextCoords(text, textBoxSize, align, Rect(Point(0), boxSize), glyphsPositions);
+}
+
 inline bool BitmapFont::clipAndTranslateGlyph(Rect& glyphScreenCoords, Rect& glyphTextureCoords, const Rect& screenCoords) const noexcept
 {
     if (glyphScreenCoords.bottom() < 0 || glyphScreenCoords.right() < 0)
@@ -173,39 +199,22 @@ void BitmapFont::fillTextCoords(const CoordsBufferPtr& coords, const std::string
     if (!screenCoords.isValid() || !m_texture)
         return;
 
-    const int textLength = static_cast<int>(text.length());
-
-    int dx = 0;
-    int dy = 0;
-
-    if (align & Fw::AlignBottom) {
-        dy = screenCoords.height() - textBoxSize.height();
-    } else if (align & Fw::AlignVerticalCenter) {
-        dy = (screenCoords.height() - textBoxSize.height()) / 2;
-    }
+    const Size boxSize = screenCoords.size();
 
-    if (align & Fw::AlignRight) {
-        dx = screenCoords.width() - textBoxSize.width();
-    } else if (align & Fw::AlignHorizontalCenter) {
-        dx = (screenCoords.width() - textBoxSize.width()) / 2;
+    auto layout = g_fonts.getTextLayout(this, text, align, boxSize);
+    if (!layout) {
+        auto newLayout = std::make_shared<FontManager::TextLayout>();
+        newLayout->textBoxSize = textBoxSize;
+        newLayout->coords = getRelativeTextCoords(text, textBoxSize, align, boxSize, glyphsPositions);
+        g_fonts.cacheTextLayout(this, text, align, boxSize, newLayout);
+        layout = std::move(newLayout);
     }
 
     const AtlasRegion* region = m_texture->getAtlasRegion();
+    const Point textureOffset = region ? Point(region->x, region->y) : Point(0);
 
-    for (int i = 0; i < textLength; ++i) {
-        const int glyph = static_cast<uint8_t>(text[i]);
-        if (glyph < 32) continue;
-
-        Rect glyphScreenCoords(glyphsPositions[i] + Point(dx, dy), m_glyphsSize[glyph]);
-        Rect glyphTextureCoords = m_glyphsTextureCoords[glyph];
-
-        if (!clipAndTranslateGlyph(glyphScreenCoords, glyphTextureCoords, screenCoords))
-            continue;
-
-        if (region)
-            glyphTextureCoords.translate(region->x, region->y);
-
-        coords->addRect(glyphScreenCoords, glyphTextureCoords);
+    for (const auto& [glyphScreenCoords, glyphTextureCoords] : layout->coords) {
+        coords->addRect(glyphScreenCoords.translated(screenCoords.topLeft()), glyphTextureCoords.translated(textureOffset));
     }
 }
 
@@ -287,13 +296,41 @@ void BitmapFont::calculateGlyphsPositions(std::string_view text,
                                           Fw::AlignmentFlag align,
                                           std::vector<Point>& glyphsPositions,
                                           Size* textBoxSize) const noexcept
+{
+    Size boxSize;
+    if (text.empty()) {
+        layoutGlyphs(text, align, glyphsPositions, boxSize);
+    } else if (const auto& layout = g_fonts.getGlyphsLayout(this, text, align)) {
+        const auto& positions = layout->glyphsPositions;
+        if (glyphsPositions.size() < positions.size())
+            glyphsPositions.resize(positions.size());
+        std::copy(positions.begin(), positions.end(), glyphsPositions.begin());
+        boxSize = layout->textBoxSize;
+    } else {
+        layoutGlyphs(text, align, glyphsPositions, boxSize);
+        if (text.size() <= FontManager::MAX_CACHED_TEXT_LENGTH) {
+            auto newLayout = std::make_shared<FontManager::TextLayout>();
+            newLayout->glyphsPositions.assign(glyphsPositions.begin(), glyphsPositions.begin() + text.size());
+            newLayout->textBoxSize = boxSize;
+            g_fonts.cacheGlyphsLayout(this, text, align, std::move(newLayout));
+        }
+    }
+
+    if (textBoxSize)
+        *textBoxSize = boxSize;
+}
+
+void BitmapFont::layoutGlyphs(const std::string_view text,
+                              const Fw::AlignmentFlag align,
+                              std::vector<Point>& glyphsPositions,
+                              Size& textBoxSize) const noexcept
 {
     const int textLength = static_cast<int>(text.size());
     int maxLineWidth = 0;
     int lines = 0;
 
-    if (textBoxSize && textLength == 0) {
-        textBoxSize->resize(0, m_glyphHeight);
+    if (textLength == 0) {
+        textBoxSize.resize(0, m_glyphHeight);
         return;
     }
 
@@ -305,29 +342,25 @@ void BitmapFont::calculateGlyphsPositions(std::string_view text,
     const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
     const Size* __restrict widths = m_glyphsSize;
 
-    const bool needLines =
-        (align & Fw::AlignRight) || (align & Fw::AlignHorizontalCenter) || (textBoxSize != nullptr);
+    // line widths are always measured, the cached layout carries the text box size
+    if (s_lineWidths.empty()) s_lineWidths.resize(1);
+    s_lineWidths[0] = 0;
 
-    if (needLines) {
-        if (s_lineWidths.empty()) s_lineWidths.resize(1);
-        s_lineWidths[0] = 0;
-
-        for (int i = 0; i < textLength; ++i) {
-            const unsigned char g = p[i];
-            if (g == static_cast<unsigned char>('\n')) {
-                ++lines;
-                if (lines + 1 > static_cast<int>(s_lineWidths.size()))
-                    s_lineWidths.resize(lines + 1);
-                s_lineWidths[lines] = 0;
-                continue;
-            }
-            if (g >= 32) {
-                s_lineWidths[lines] += widths[g].width();
-                if (i + 1 != textLength && p[i + 1] != static_cast<unsigned char>('\n'))
-                    s_lineWidths[lines] += m_glyphSpacing.width();
-                if (s_lineWidths[lines] > maxLineWidth)
-                    maxLineWidth = s_lineWidths[lines];
-            }
+    for (int i = 0; i < textLength; ++i) {
+        const unsigned char g = p[i];
+        if (g == static_cast<unsigned char>('\n')) {
+            ++lines;
+            if (lines + 1 > static_cast<int>(s_lineWidths.size()))
+                s_lineWidths.resize(lines + 1);
+            s_lineWidths[lines] = 0;
+            continue;
+        }
+        if (g >= 32) {
+            s_lineWidths[lines] += widths[g].width();
+            if (i + 1 != textLength && p[i + 1] != static_cast<unsigned char>('\n'))
+                s_lineWidths[lines] += m_glyphSpacing.width();
+            if (s_lineWidths[lines] > maxLineWidth)
+                maxLineWidth = s_lineWidths[lines];
         }
     }
 
@@ -343,9 +376,9 @@ void BitmapFont::calculateGlyphsPositions(std::string_view text,
                 ++lines;
             }
             if (align & Fw::AlignRight) {
-                vpos.x = (maxLineWidth - (needLines ? s_lineWidths[lines] : 0));
+                vpos.x = (maxLineWidth - s_lineWidths[lines]);
             } else if (align & Fw::AlignHorizontalCenter) {
-                vpos.x = (maxLineWidth - (needLines ? s_lineWidths[lines] : 0)) / 2;
+                vpos.x = (maxLineWidth - s_lineWidths[lines]) / 2;
             } else {
                 vpos.x = 0;
             }
@@ -357,10 +390,8 @@ void BitmapFont::calculateGlyphsPositions(std::string_view text,
         }
     }
 
-    if (textBoxSize) {
-        textBoxSize->setWidth(maxLineWidth);
-        textBoxSize->setHeight(vpos.y + m_glyphHeight);
-    }
+    textBoxSize.setWidth(maxLineWidth);
+    textBoxSize.setHeight(vpos.y + m_glyphHeight);
 }
 
 Size BitmapFont::calculateTextRectSize(const std::string_view text)
@@ -87,6 +87,10 @@ private:
         return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
     }
 
+    void layoutGlyphs(std::string_view text, Fw::AlignmentFlag align, std::vector<Point>& glyphsPositions, Size& textBoxSize) const noexcept;
+    std::vector<std::pair<Rect, Rect>> getRelativeTextCoords(std::string_view text, const Size& textBoxSize, Fw::AlignmentFlag align,
+                                                             const Size& boxSize, const std::vector<Point>& glyphsPositions) const noexcept;
+
     inline bool clipAndTranslateGlyph(Rect& glyphScreenCoords, Rect& glyphTextureCoords, const Rect& screenCoords) const noexcept;
 
     std::string m_name;
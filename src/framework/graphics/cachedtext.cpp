@@ -29,22 +29,32 @@
 CachedText::CachedText() : m_align(Fw::AlignCenter), m_coordsBuffer(std::make_shared<CoordsBuffer>()) {}
 
 void CachedText::draw(const Rect& rect, const Color& color)
+{
+    if (getCoords(rect))
+        g_drawPool.addTexturedCoordsBuffer(m_font->getTexture(), m_coordsBuffer, color);
+}
+
+const CoordsBuffer* CachedText::getCoords(const Rect& rect)
 {
     if (!m_font)
-        return;
+        return nullptr;
 
     // Hack to fix font rendering in atlas
-    if (m_font->getAtlasRegion() != m_atlasRegion) {
-        m_atlasRegion = m_font->getAtlasRegion();
+    if (m_atlasRegion.update(m_font->getAtlasRegion())) {
         m_textScreenCoords = {};
     }
 
     if (m_textScreenCoords != rect) {
+        // the layout only depends on the box size, a box that just moved keeps its glyphs
+        if (m_textScreenCoords.isValid() && m_textScreenCoords.size() == rect.size())
+            m_coordsBuffer->translate(rect.topLeft() - m_textScreenCoords.topLeft());
+        else
+            m_font->fillTextCoords(m_coordsBuffer, m_text, m_textSize, m_align, rect, m_glyphsPositions);
+
         m_textScreenCoords = rect;
-        m_font->fillTextCoords(m_coordsBuffer, m_text, m_textSize, m_align, rect, m_glyphsPositions);
     }
 
-    g_drawPool.addTexturedCoordsBuffer(m_font->getTexture(), m_coordsBuffer, color);
+    return m_coordsBuffer.get();
 }
 
 void CachedText::update()
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "declarations.h"
+#include "textureatlas.h"
 
 class CachedText
 {
@@ -31,6 +32,9 @@ public:
 
     void draw(const Rect& rect, const Color& color);
 
+    // glyph coords laid out in rect, null without a font
+    const CoordsBuffer* getCoords(const Rect& rect);
+
     void wrapText(int maxWidth);
     void setFont(const BitmapFontPtr& font);
     void setText(std::string_view text);
@@ -54,7 +58,7 @@ private:
     BitmapFontPtr m_font;
     Fw::AlignmentFlag m_align;
 
-    const AtlasRegion* m_atlasRegion = nullptr;
+    AtlasRegionRef m_atlasRegion;
 
     CoordsBufferPtr m_coordsBuffer;
 };
@@ -22,6 +22,46 @@
 
 #include "coordsbuffer.h"
 
+void CoordsBuffer::addUpsideDownQuad(const Rect& dest, const Rect& src)
+{
+    const float top = dest.top();
+    const float right = dest.right() + 1;
+    const float bottom = dest.bottom() + 1;
+    const float left = dest.left();
+
+    const float srcTop = src.top();
+    const float srcRight = src.right() + 1;
+    const float srcBottom = src.bottom() + 1;
+    const float srcLeft = src.left();
+
+    auto* out = growTextured(4);
+    out[0] = { left, bottom, srcLeft, srcTop };
+    out[1] = { right, bottom, srcRight, srcTop };
+    out[2] = { left, top, srcLeft, srcBottom };
+    out[3] = { right, top, srcLeft, srcBottom };
+}
+
+void CoordsBuffer::addUpsideDownRect(const Rect& dest, const Rect& src)
+{
+    const float top = dest.top();
+    const float right = dest.right() + 1;
+    const float bottom = dest.bottom() + 1;
+    const float left = dest.left();
+
+    const float srcTop = src.top();
+    const float srcRight = src.right() + 1;
+    const float srcBottom = src.bottom() + 1;
+    const float srcLeft = src.left();
+
+    auto* out = growTextured(6);
+    out[0] = { left, bottom, srcLeft, srcTop };
+    out[1] = { right, bottom, srcRight, srcTop };
+    out[2] = { left, bottom, srcLeft, srcBottom };
+    out[3] = { left, top, srcLeft, srcBottom };
+    out[4] = { right, bottom, srcRight, srcTop };
+    out[5] = { right, top, srcRight, srcBottom };
+}
+
 void CoordsBuffer::addBoudingRect(const Rect& dest, const int innerLineWidth)
 {
     const int left = dest.left();
@@ -60,8 +100,7 @@ void CoordsBuffer::addRepeatedRects(const Rect& dest, const Rect& src)
             }
 
             partialDest.translate(dest.topLeft());
-            m_vertexArray.addRect(partialDest);
-            m_textureCoordArray.addRect(partialSrc);
+            writeRect(growTextured(6), partialDest, partialSrc);
         }
     }
 }
\ No newline at end of file
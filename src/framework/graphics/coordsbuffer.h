@@ -22,77 +22,161 @@
 
 #pragma once
 
-#include "vertexarray.h"
+#include "declarations.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COORDS_BUFFER_SSE2
+#endif
+
+// position and texture coordinate of one vertex, interleaved so a draw reads a single stream
+struct CoordsVertex
+{
+    float x, y, u, v;
+};
 
 class CoordsBuffer
 {
 public:
+    static constexpr int STRIDE = sizeof(CoordsVertex);
 
-    CoordsBuffer(const size_t size = 64) : m_vertexArray(size), m_textureCoordArray(size) {}
+    CoordsBuffer(const size_t size = 64) { m_vertices.reserve(size); }
 
+    // keeps the storage, the next frame writes over it
     void clear()
     {
-        m_textureCoordArray.clear();
-        m_vertexArray.clear();
+        m_size = 0;
+        m_texturedSize = 0;
     }
 
     void addTriangle(const Point& a, const Point& b, const Point& c)
     {
-        m_vertexArray.addTriangle(a, b, c);
+        auto* out = grow(3);
+        out[0] = { static_cast<float>(a.x), static_cast<float>(a.y), 0.f, 0.f };
+        out[1] = { static_cast<float>(b.x), static_cast<float>(b.y), 0.f, 0.f };
+        out[2] = { static_cast<float>(c.x), static_cast<float>(c.y), 0.f, 0.f };
     }
     void addRect(const Rect& dest)
     {
-        m_vertexArray.addRect(dest);
+        writeRect(grow(6), dest.left(), dest.top(), dest.right() + 1, dest.bottom() + 1, 0.f, 0.f, 0.f, 0.f);
     }
     void addRect(const Rect& dest, const Rect& src)
     {
-        m_vertexArray.addRect(dest);
-        if (src.isValid())
-            m_textureCoordArray.addRect(src);
+        if (!src.isValid()) {
+            addRect(dest);
+            return;
+        }
+
+        writeRect(growTextured(6), dest, src);
     }
 
     void addRect(const RectF& dest, const RectF& src)
     {
-        m_vertexArray.addRect(dest);
-        m_textureCoordArray.addRect(src);
+        writeRect(growTextured(6), dest.left(), dest.top(), dest.right() + 1.f, dest.bottom() + 1.f,
+                  src.left(), src.top(), src.right() + 1.f, src.bottom() + 1.f);
     }
 
     void addQuad(const Rect& dest, const Rect& src)
     {
-        m_vertexArray.addQuad(dest);
-        m_textureCoordArray.addQuad(src);
+        writeRect(growTextured(6), dest, src);
     }
-    void addUpsideDownQuad(const Rect& dest, const Rect& src)
+    void addUpsideDownQuad(const Rect& dest, const Rect& src);
+    void addUpsideDownRect(const Rect& dest, const Rect& src);
+
+    void addBoudingRect(const Rect& dest, int innerLineWidth);
+    void addRepeatedRects(const Rect& dest, const Rect& src);
+
+    void translate(const Point& offset)
     {
-        m_vertexArray.addUpsideDownQuad(dest);
-        m_textureCoordArray.addQuad(src);
+        const float x = offset.x;
+        const float y = offset.y;
+        for (size_t i = 0; i < m_size; ++i) {
+            m_vertices[i].x += x;
+            m_vertices[i].y += y;
+        }
     }
 
-    void addUpsideDownRect(const Rect& dest, const Rect& src)
+    void append(const CoordsBuffer* buffer)
     {
-        m_vertexArray.addUpsideDownRect(dest);
-        m_textureCoordArray.addRect(src);
+        if (buffer->m_size == 0)
+            return;
+
+        std::copy_n(buffer->m_vertices.data(), buffer->m_size, grow(buffer->m_size));
+        m_texturedSize += buffer->m_texturedSize;
     }
 
-    void addBoudingRect(const Rect& dest, int innerLineWidth);
-    void addRepeatedRects(const Rect& dest, const Rect& src);
+    const float* getVertexArray() const { return &m_vertices.data()->x; }
+    const float* getTextureCoordArray() const { return &m_vertices.data()->u; }
+    int getVertexCount() const { return static_cast<int>(m_size); }
+    int getTextureCoordCount() const
+    {
+        // the painter binds the texture coords of every vertex or of none, so textured and
+        // solid quads can't share a buffer
+        assert(m_texturedSize == 0 || m_texturedSize == m_size);
+        return static_cast<int>(m_texturedSize);
+    }
 
-    void append(const CoordsBuffer* buffer)
+    size_t size() const { return m_size; }
+
+private:
+    // bump allocation in storage that only ever grows, so steady frames never allocate
+    CoordsVertex* grow(const size_t count)
+    {
+        if (m_size + count > m_vertices.size())
+            m_vertices.resize(std::max<size_t>({ m_vertices.capacity(), m_vertices.size() * 2, m_size + count }));
+
+        auto* out = m_vertices.data() + m_size;
+        m_size += count;
+        return out;
+    }
+
+    CoordsVertex* growTextured(const size_t count)
     {
-        m_vertexArray.append(&buffer->m_vertexArray);
-        m_textureCoordArray.append(&buffer->m_textureCoordArray);
+        m_texturedSize += count;
+        return grow(count);
     }
 
-    const float* getVertexArray() const { return m_vertexArray.vertices(); }
-    const float* getTextureCoordArray() const { return m_textureCoordArray.vertices(); }
-    int getVertexCount() const { return m_vertexArray.vertexCount(); }
-    int getTextureCoordCount() const { return m_textureCoordArray.vertexCount(); }
+    static void writeRect(CoordsVertex* out, const float left, const float top, const float right, const float bottom,
+                          const float srcLeft, const float srcTop, const float srcRight, const float srcBottom)
+    {
+        out[0] = { left, top, srcLeft, srcTop };
+        out[1] = { right, top, srcRight, srcTop };
+        out[2] = { left, bottom, srcLeft, srcBottom };
+        out[3] = out[2];
+        out[4] = out[1];
+        out[5] = { right, bottom, srcRight, srcBottom };
+    }
+
+    // the common textured rect, both corners go through one conversion and the
+    // other two vertices are lane selects of them
+    static void writeRect(CoordsVertex* out, const Rect& dest, const Rect& src)
+    {
+#ifdef COORDS_BUFFER_SSE2
+        const __m128 destCoords = _mm_cvtepi32_ps(_mm_set_epi32(dest.bottom() + 1, dest.right() + 1, dest.top(), dest.left()));
+        const __m128 srcCoords = _mm_cvtepi32_ps(_mm_set_epi32(src.bottom() + 1, src.right() + 1, src.top(), src.left()));
 
-    size_t size() const {
-        return  std::max<size_t>(m_vertexArray.size(), m_textureCoordArray.size());
+        const __m128 topLeft = _mm_movelh_ps(destCoords, srcCoords);
+        const __m128 bottomRight = _mm_movehl_ps(srcCoords, destCoords);
+
+        // lanes x and u from the first operand, y and v from the second
+        const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, -1));
+        const __m128 topRight = _mm_or_ps(_mm_and_ps(mask, bottomRight), _mm_andnot_ps(mask, topLeft));
+        const __m128 bottomLeft = _mm_or_ps(_mm_and_ps(mask, topLeft), _mm_andnot_ps(mask, bottomRight));
+
+        auto* dst = &out->x;
+        _mm_storeu_ps(dst + 0, topLeft);
+        _mm_storeu_ps(dst + 4, topRight);
+        _mm_storeu_ps(dst + 8, bottomLeft);
+        _mm_storeu_ps(dst + 12, bottomLeft);
+        _mm_storeu_ps(dst + 16, topRight);
+        _mm_storeu_ps(dst + 20, bottomRight);
+#else
+        writeRect(out, dest.left(), dest.top(), dest.right() + 1, dest.bottom() + 1,
+                  src.left(), src.top(), src.right() + 1, src.bottom() + 1);
+#endif
     }
 
-private:
-    VertexArray m_vertexArray;
-    VertexArray m_textureCoordArray;
+    std::vector<CoordsVertex> m_vertices;
+    size_t m_size{ 0 };
+    size_t m_texturedSize{ 0 };
 };
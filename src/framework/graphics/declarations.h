@@ -83,12 +83,13 @@ class Image;
 class AnimatedTexture;
 class BitmapFont;
 class CachedText;
+class TextBatch;
 class FrameBuffer;
 class FrameBufferManager;
 class Shader;
 class ShaderProgram;
 class PainterShaderProgram;
-class Particle;
+class ParticleBuffer;
 class ParticleType;
 class ParticleEmitter;
 class ParticleAffector;
@@ -115,7 +116,6 @@ using FrameBufferPtr = std::shared_ptr<FrameBuffer>;
 using ShaderPtr = std::shared_ptr<Shader>;
 using ShaderProgramPtr = std::shared_ptr<ShaderProgram>;
 using PainterShaderProgramPtr = std::shared_ptr<PainterShaderProgram>;
-using ParticlePtr = std::shared_ptr<Particle>;
 using ParticleTypePtr = std::shared_ptr<ParticleType>;
 using ParticleEmitterPtr = std::shared_ptr<ParticleEmitter>;
 using ParticleAffectorPtr = std::shared_ptr<ParticleAffector>;
@@ -52,6 +52,9 @@ DrawPool* DrawPool::create(const DrawPoolType type)
 
 void DrawPool::add(const Color& color, const TexturePtr& texture, DrawMethod&& method, const CoordsBufferPtr& coordsBuffer)
 {
+    if (m_capture)
+        capture(color, texture, method, coordsBuffer);
+
     Texture* textureAtlas = nullptr;
 
     if (texture) {
@@ -73,25 +76,41 @@ void DrawPool::add(const Color& color, const TexturePtr& texture, DrawMethod&& m
         return;
 
     auto& list = m_objects[m_currentDrawOrder];
-    auto& state = getCurrentState();
+    const auto& state = getCurrentState();
+
+    // coords buffers and transformed draws may land anywhere, they overlap everything.
+    const auto& bounds = coordsBuffer || state.transformMatrix != DEFAULT_MATRIX3 ? UNBOUNDED_RECT : getBounds(method);
 
-    if (!list.empty() && list.back().state == state) {
+    uint32_t coordsIndex = NO_INDEX;
+    if (!list.empty() && list.back().hasCoords() && m_recording.states[list.back().state] == state) {
         auto& last = list.back();
-        coordsBuffer ? last.coords->append(coordsBuffer.get()) : addCoords(*last.coords, method);
+        last.bounds = last.bounds.united(bounds);
+        coordsIndex = last.coords;
     } else if (m_alwaysGroupDrawings) {
-        auto& coords = m_coords.try_emplace(state.hash, nullptr).first->second;
-        if (!coords) {
-            coords = list.emplace_back(getState(texture, textureAtlas, color), getCoordsBuffer()).coords.get();
-        }
-        coordsBuffer ? coords->append(coordsBuffer.get()) : addCoords(*coords, method);
+        auto& groupIndex = m_coords.try_emplace(state.hash, NO_INDEX).first->second;
+        if (groupIndex == NO_INDEX)
+            groupIndex = addDrawObject(list, texture, textureAtlas, color).coords;
+        coordsIndex = groupIndex;
     } else {
-        auto& draw = list.emplace_back(getState(texture, textureAtlas, color), getCoordsBuffer());
-        coordsBuffer ? draw.coords->append(coordsBuffer.get()) : addCoords(*draw.coords, method);
+        auto& draw = addDrawObject(list, texture, textureAtlas, color);
+        draw.bounds = bounds;
+        coordsIndex = draw.coords;
     }
 
+    auto& coords = m_recording.coords[coordsIndex];
+    coordsBuffer ? coords.append(coordsBuffer.get()) : addCoords(coords, method);
+
     resetOnlyOnceParameters();
 }
 
+DrawPool::DrawObject& DrawPool::addDrawObject(std::vector<DrawObject>& list, const TexturePtr& texture, Texture* textureAtlas, const Color& color)
+{
+    return list.emplace_back(DrawObject{
+        .state = m_recording.addState(getState(texture, textureAtlas, color)),
+        .coords = m_recording.acquireCoords()
+    });
+}
+
 void DrawPool::addCoords(CoordsBuffer& buffer, const DrawMethod& method)
 {
     if (method.type == DrawMethodType::BOUNDING_RECT) {
@@ -107,6 +126,19 @@ void DrawPool::addCoords(CoordsBuffer& buffer, const DrawMethod& method)
     }
 }
 
+Rect DrawPool::getBounds(const DrawMethod& method)
+{
+    if (method.type == DrawMethodType::TRIANGLE) {
+        const int left = std::min<int>({ method.a.x, method.b.x, method.c.x });
+        const int top = std::min<int>({ method.a.y, method.b.y, method.c.y });
+        const int right = std::max<int>({ method.a.x, method.b.x, method.c.x });
+        const int bottom = std::max<int>({ method.a.y, method.b.y, method.c.y });
+        return { Point(left, top), Point(right, bottom) };
+    }
+
+    return method.dest;
+}
+
 bool DrawPool::updateHash(const DrawMethod& method, const Texture* texture, const Color& color, const bool hasCoord) {
     auto& state = getCurrentState();
     state.hash = 0;
@@ -181,7 +213,7 @@ DrawPool::PoolState DrawPool::getState(const TexturePtr& texture, Texture* textu
             (m_atlas && m_atlas->canAdd(texture)) // Force this texture to be packed into the current pool atlas,
                                                   // even if it might already belong to another DrawPool's atlas
         ) {
-            copy.texture = texture;
+            copy.texture = m_recording.addTexture(texture);
         } else {
             // Standalone GL texture cached in memory (non-atlased)
             copy.textureId = texture->getId();
@@ -189,6 +221,9 @@ DrawPool::PoolState DrawPool::getState(const TexturePtr& texture, Texture* textu
         }
     }
 
+    if (const auto& action = m_shaderActions[m_lastStateIndex])
+        copy.action = m_recording.addAction(action);
+
     return copy;
 }
 
@@ -226,10 +261,10 @@ void DrawPool::setShaderProgram(const PainterShaderProgramPtr& shaderProgram, co
             m_shaderRefreshDelay = FPS20;
 
         getCurrentState().shaderProgram = shaderProgram.get();
-        getCurrentState().action = action;
+        m_shaderActions[m_lastStateIndex] = action;
     } else {
         getCurrentState().shaderProgram = nullptr;
-        getCurrentState().action = nullptr;
+        m_shaderActions[m_lastStateIndex] = nullptr;
     }
 
     if (onlyOnce) m_onlyOnceStateFlag |= STATE_SHADER_PROGRAM;
@@ -243,6 +278,7 @@ void DrawPool::resetState()
     m_hashCtrl.reset();
 
     getCurrentState() = {};
+    m_shaderActions[m_lastStateIndex] = nullptr;
     m_lastFramebufferId = 0;
     m_shaderRefreshDelay = 0;
     m_scale = DEFAULT_DISPLAY_DENSITY;
@@ -260,83 +296,130 @@ bool DrawPool::canRepaint()
 }
 
 void DrawPool::release() {
-    SpinLock::Guard guard(m_threadLock);
-
     if (!canRepaint()) {
         for (auto& objs : m_objects)
             objs.clear();
         m_objectsFlushed.clear();
+        m_recording.clear();
         return;
     }
 
     m_refreshTimer.restart();
 
-    m_objectsDraw[0].clear();
+    sortObjects();
 
-    if (!m_objectsFlushed.empty()) {
-        if (m_objectsDraw[0].size() < m_objectsFlushed.size())
-            m_objectsDraw[0].swap(m_objectsFlushed);
+    auto& objects = m_recording.objects;
+    objects.clear();
+    appendObjects(objects, m_objectsFlushed);
+    for (auto& objs : m_objects)
+        appendObjects(objects, objs);
 
-        if (!m_objectsFlushed.empty()) {
-            m_objectsDraw[0].insert(
-                m_objectsDraw[0].end(),
-                std::make_move_iterator(m_objectsFlushed.begin()),
-                std::make_move_iterator(m_objectsFlushed.end()));
-        }
-        m_objectsFlushed.clear();
+    if (m_batchSorting) {
+        m_batchCountBeforeSort.store(m_batchCountBefore, std::memory_order_relaxed);
+        m_batchCountAfterSort.store(m_batchCountAfter, std::memory_order_relaxed);
+        m_batchCountBefore = m_batchCountAfter = 0;
     }
 
-    for (auto& objs : m_objects) {
-        if (m_objectsDraw[0].size() < objs.size())
-            m_objectsDraw[0].swap(objs);
+    m_recording.atlasEpoch = m_atlas ? m_atlas->getEpoch() : 0;
 
-        bool addFirst = true;
+    {
+        SpinLock::Guard guard(m_threadLock);
+        std::swap(m_objectsDraw[0], m_recording);
+        m_shouldRepaint.store(true, std::memory_order_release);
+    }
 
-        if (!m_objectsDraw[0].empty() && !objs.empty()) {
-            auto& last = m_objectsDraw[0].back();
-            auto& first = objs.front();
+    // m_recording now holds the arena previously in m_objectsDraw[0], the render thread no longer reads it.
+    m_recording.clear();
+}
 
-            if (last.state == first.state && last.coords && first.coords) {
-                last.coords->append(first.coords.get());
-                addFirst = false;
+void DrawPool::flush()
+{
+    m_coords.clear();
+
+    sortObjects();
+
+    for (auto& objs : m_objects)
+        appendObjects(m_objectsFlushed, objs);
+}
+
+void DrawPool::sortObjects()
+{
+    // always grouped pools already merge by state regardless of order
+    if (!m_batchSorting || m_alwaysGroupDrawings)
+        return;
+
+    for (auto& objs : m_objects)
+        sortObjects(objs);
+}
+
+void DrawPool::sortObjects(std::vector<DrawObject>& objects)
+{
+    // how far back a draw may look for a batch with the same state
+    static constexpr int MAX_LOOK_BEHIND = 64;
+
+    if (objects.size() < 2)
+        return;
+
+    const auto countBatches = [](const std::vector<DrawObject>& objs) {
+        return static_cast<uint32_t>(std::ranges::count_if(objs, [](const DrawObject& obj) { return obj.hasCoords(); }));
+    };
+
+    m_batchCountBefore += countBatches(objects);
+
+    std::vector<DrawObject> sorted;
+    sorted.reserve(objects.size());
+
+    for (const auto& obj : objects) {
+        bool merged = false;
+
+        if (obj.hasCoords()) {
+            const auto& state = m_recording.states[obj.state];
+            for (int i = static_cast<int>(sorted.size()) - 1, limit = std::max<int>(0, i - MAX_LOOK_BEHIND); i >= limit; --i) {
+                auto& prev = sorted[i];
+
+                // actions may change anything, never move draws across them
+                if (!prev.hasCoords())
+                    break;
+
+                if (m_recording.states[prev.state] == state) {
+                    // everything after prev does not overlap obj, drawing it earlier keeps the same pixels
+                    m_recording.coords[prev.coords].append(&m_recording.coords[obj.coords]);
+                    prev.bounds = prev.bounds.united(obj.bounds);
+                    merged = true;
+                    break;
+                }
+
+                if (prev.bounds.intersects(obj.bounds))
+                    break;
             }
         }
 
-        if (!objs.empty()) {
-            m_objectsDraw[0].insert(
-                m_objectsDraw[0].end(),
-                std::make_move_iterator(objs.begin() + (addFirst ? 0 : 1)),
-                std::make_move_iterator(objs.end()));
-            objs.clear();
-        }
+        if (!merged)
+            sorted.emplace_back(obj);
     }
 
-    m_shouldRepaint.store(true, std::memory_order_release);
+    m_batchCountAfter += countBatches(sorted);
+    objects.swap(sorted);
 }
 
-void DrawPool::flush()
+void DrawPool::appendObjects(std::vector<DrawObject>& dest, std::vector<DrawObject>& src)
 {
-    m_coords.clear();
+    if (src.empty())
+        return;
 
-    for (auto& objs : m_objects) {
-        bool addFirst = true;
-        if (!objs.empty() && !m_objectsFlushed.empty()) {
-            auto& last = m_objectsFlushed.back();
-            auto& first = objs.front();
+    auto begin = src.begin();
+    if (!dest.empty()) {
+        const auto& last = dest.back();
+        const auto& first = src.front();
 
-            if (last.state == first.state && last.coords && first.coords) {
-                last.coords->append(first.coords.get());
-                addFirst = false;
-            }
+        if (last.hasCoords() && first.hasCoords() && m_recording.states[last.state] == m_recording.states[first.state]) {
+            m_recording.coords[last.coords].append(&m_recording.coords[first.coords]);
+            ++begin;
         }
-
-        m_objectsFlushed.insert(
-            m_objectsFlushed.end(),
-            std::make_move_iterator(objs.begin() + (addFirst ? 0 : 1)),
-            std::make_move_iterator(objs.end())
-        );
-        objs.clear();
     }
+
+    dest.insert(dest.end(), begin, src.end());
+    src.clear();
 }
 
 void DrawPool::scale(const float factor)
@@ -394,7 +477,7 @@ void DrawPool::popTransformMatrix()
     m_transformMatrixStack.pop_back();
 }
 
-void DrawPool::PoolState::execute(DrawPool* pool) const {
+void DrawPool::PoolState::execute(DrawPool* pool, const TexturePtr& texture, const std::function<void()>* action) const {
     g_painter->setColor(color);
     g_painter->setOpacity(opacity);
     g_painter->setCompositionMode(compositionMode);
@@ -402,7 +485,7 @@ void DrawPool::PoolState::execute(DrawPool* pool) const {
     g_painter->setClipRect(clipRect);
     g_painter->setShaderProgram(shaderProgram);
     g_painter->setTransformMatrix(transformMatrix);
-    if (action) action();
+    if (action && *action) (*action)();
     if (texture) {
         texture->create();
         g_painter->setTexture(texture);
@@ -413,6 +496,31 @@ void DrawPool::PoolState::execute(DrawPool* pool) const {
         g_painter->setTexture(textureId, textureMatrixId);
 }
 
+void DrawPool::DrawArena::execute(DrawPool* pool, const DrawObject& obj) const {
+    if (!obj.hasCoords()) {
+        if (obj.action != NO_INDEX)
+            actions[obj.action]();
+        return;
+    }
+
+    static const TexturePtr noTexture;
+
+    const auto& state = states[obj.state];
+    state.execute(pool, state.texture != NO_INDEX ? textures[state.texture] : noTexture, state.action != NO_INDEX ? &actions[state.action] : nullptr);
+    g_painter->drawCoords(coords[obj.coords], DrawMode::TRIANGLES);
+}
+
+void DrawPool::DrawArena::clear() {
+    objects.clear();
+    states.clear();
+    textures.clear();
+    actions.clear();
+
+    for (uint32_t i = 0; i < coordsCount; ++i)
+        coords[i].clear();
+    coordsCount = 0;
+}
+
 void DrawPool::setFramebuffer(const Size& size) {
     if (!m_framebuffer) {
         m_framebuffer = std::make_shared<FrameBuffer>();
@@ -430,10 +538,91 @@ void DrawPool::removeFramebuffer() {
     m_framebuffer = nullptr;
 }
 
+void DrawPool::beginCapture(DrawCommandList* commands, const Point& origin)
+{
+    commands->clear();
+    commands->origin = origin;
+    m_capture = commands;
+    m_captureValid = true;
+}
+
+void DrawPool::capture(const Color& color, const TexturePtr& texture, const DrawMethod& method, const CoordsBufferPtr& coordsBuffer)
+{
+    // coords buffers are built at absolute positions and can't be moved to another origin
+    if (coordsBuffer || m_capture->states.size() > UINT16_MAX) {
+        m_captureValid = false;
+        return;
+    }
+
+    const auto& state = getCurrentState();
+    const auto& shaderAction = m_shaderActions[m_lastStateIndex];
+
+    // shader actions can't be compared, a state with a shader always starts a new entry
+    auto& states = m_capture->states;
+    const bool sameState = !states.empty() && !state.shaderProgram && !states.back().state.shaderProgram
+        && states.back().state.transformMatrix == state.transformMatrix
+        && states.back().state.opacity == state.opacity
+        && states.back().state.compositionMode == state.compositionMode
+        && states.back().state.blendEquation == state.blendEquation
+        && states.back().state.clipRect == state.clipRect;
+
+    if (!sameState)
+        states.emplace_back(DrawCommandList::State{ state, shaderAction });
+
+    m_capture->commands.emplace_back(DrawCommandList::Command{
+        .color = color,
+        .texture = texture,
+        .method = method,
+        .state = static_cast<uint16_t>(states.size() - 1),
+        .order = m_currentDrawOrder
+    });
+}
+
+void DrawPool::replay(const DrawCommandList& commands, const Point& origin)
+{
+    const auto state = getCurrentState();
+    auto shaderAction = std::move(m_shaderActions[m_lastStateIndex]);
+    const auto order = m_currentDrawOrder;
+    const auto onlyOnceStateFlag = m_onlyOnceStateFlag;
+    m_onlyOnceStateFlag = 0;
+
+    const auto offset = origin - commands.origin;
+    int lastState = -1;
+
+    for (const auto& command : commands.commands) {
+        if (command.state != lastState) {
+            lastState = command.state;
+            const auto& captured = commands.states[lastState];
+            getCurrentState() = captured.state;
+            m_shaderActions[m_lastStateIndex] = captured.shaderAction;
+        }
+
+        DrawMethod method = command.method;
+        if (!offset.isNull()) {
+            method.dest.translate(offset);
+            method.a += offset;
+            method.b += offset;
+            method.c += offset;
+        }
+
+        m_currentDrawOrder = command.order;
+        add(command.color, command.texture, std::move(method));
+    }
+
+    getCurrentState() = state;
+    m_shaderActions[m_lastStateIndex] = std::move(shaderAction);
+    m_currentDrawOrder = order;
+    m_onlyOnceStateFlag = onlyOnceStateFlag;
+}
+
 void DrawPool::addAction(const std::function<void()>& action, size_t hash)
 {
+    // actions capture live objects, a capture containing them can't be replayed
+    if (m_capture)
+        m_captureValid = false;
+
     const uint8_t order = m_type == DrawPoolType::MAP ? THIRD : FIRST;
-    m_objects[order].emplace_back(action);
+    m_objects[order].emplace_back(DrawObject{ .action = m_recording.addAction(action) });
     if (hasFrameBuffer() && hash > 0 && !m_hashCtrl.isLast(hash)) {
         m_hashCtrl.put(hash);
     }
@@ -441,6 +630,9 @@ void DrawPool::addAction(const std::function<void()>& action, size_t hash)
 
 void DrawPool::bindFrameBuffer(const Size& size, const Color& color)
 {
+    if (m_capture)
+        m_captureValid = false;
+
     ++m_bindedFramebuffers;
     ++m_lastFramebufferId;
 
@@ -452,7 +644,7 @@ void DrawPool::bindFrameBuffer(const Size& size, const Color& color)
     addAction([this, size, frameIndex = m_bindedFramebuffers] {
         static const PoolState state;
 
-        state.execute(this);
+        state.execute(this, nullptr, nullptr);
 
         const auto& frame = getTemporaryFrameBuffer(frameIndex);
         frame->resize(size);
@@ -463,10 +655,10 @@ void DrawPool::releaseFrameBuffer(const Rect& dest)
 {
     backState();
 
-    addAction([this, dest, frameIndex = m_bindedFramebuffers, drawState = getCurrentState()] {
+    addAction([this, dest, frameIndex = m_bindedFramebuffers, drawState = getCurrentState(), shaderAction = m_shaderActions[m_lastStateIndex]] {
         const auto& frame = getTemporaryFrameBuffer(frameIndex);
         frame->release();
-        drawState.execute(this);
+        drawState.execute(this, nullptr, &shaderAction);
         frame->draw(dest);
     });
 
@@ -483,22 +675,3 @@ const FrameBufferPtr& DrawPool::getTemporaryFrameBuffer(const uint8_t index) {
     tempfb->setSmooth(false);
     return tempfb;
 }
-
-std::shared_ptr<CoordsBuffer> DrawPool::getCoordsBuffer() {
-    CoordsBuffer* coordsBuffer = nullptr;
-
-    if (!m_coordsCache.empty()) {
-        coordsBuffer = m_coordsCache.back();
-        m_coordsCache.pop_back();
-    } else
-        coordsBuffer = new CoordsBuffer();
-
-    return std::shared_ptr<CoordsBuffer>(coordsBuffer, [this](CoordsBuffer* ptr) {
-        if (m_enabled) {
-            ptr->clear();
-            m_coordsCache.emplace_back(ptr);
-        } else {
-            delete ptr;
-        }
-    });
-}
\ No newline at end of file
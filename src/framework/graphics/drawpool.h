@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "coordsbuffer.h"
 #include "declarations.h"
 #include "framebuffer.h"
 #include "framework/core/timer.h"
@@ -100,6 +101,12 @@ public:
 
     void agroup(const bool agroup) { m_alwaysGroupDrawings = agroup; }
 
+    // reorders each draw order bucket by state wherever painter's order allows it.
+    void setBatchSorting(const bool v) { m_batchSorting = v; }
+    bool isBatchSorting() const { return m_batchSorting; }
+    uint32_t getBatchCountBeforeSort() const { return m_batchCountBeforeSort.load(std::memory_order_relaxed); }
+    uint32_t getBatchCountAfterSort() const { return m_batchCountAfterSort.load(std::memory_order_relaxed); }
+
     void setScaleFactor(const float scale) { m_scaleFactor = scale; }
     float getScaleFactor() const { return m_scaleFactor; }
     bool isScaled() const { return m_scaleFactor != DEFAULT_DISPLAY_DENSITY; }
@@ -145,6 +152,10 @@ protected:
         uint16_t intValue{ 0 };
     };
 
+    static constexpr uint32_t NO_INDEX = UINT32_MAX;
+    inline static const Rect UNBOUNDED_RECT{ -(1 << 29), -(1 << 29), 1 << 30, 1 << 30 };
+
+    // recorded state, texture and shader action are stored out of line in the arena.
     struct PoolState
     {
         Matrix3 transformMatrix = DEFAULT_MATRIX3;
@@ -153,26 +164,85 @@ protected:
         BlendEquation blendEquation{ BlendEquation::ADD };
         Rect clipRect;
         PainterShaderProgram* shaderProgram{ nullptr };
-        std::function<void()> action{ nullptr };
         Color color{ Color::white };
-        TexturePtr texture;
         uint32_t textureId{ 0 };
+        uint32_t texture{ NO_INDEX };
+        uint32_t action{ NO_INDEX };
         uint16_t textureMatrixId{ 0 };
         size_t hash{ 0 };
 
         bool operator==(const PoolState& s2) const { return hash == s2.hash; }
-        void execute(DrawPool* pool) const;
+        void execute(DrawPool* pool, const TexturePtr& texture, const std::function<void()>* action) const;
     };
 
+    // a command is either an action or a state + coords pair, all indices into the owning arena.
     struct DrawObject
     {
-        DrawObject(std::function<void()> action) : action(std::move(action)) {}
-        DrawObject(PoolState&& state, std::shared_ptr<CoordsBuffer>&& coords) : coords(std::move(coords)), state(std::move(state)) {}
-        std::function<void()> action{ nullptr };
-        std::shared_ptr<CoordsBuffer> coords;
-        PoolState state;
+        uint32_t state{ NO_INDEX };
+        uint32_t coords{ NO_INDEX };
+        uint32_t action{ NO_INDEX };
+        Rect bounds; // conservative screen area touched by coords, used by the batch sorting pass
+
+        bool hasCoords() const { return coords != NO_INDEX; }
+    };
+
+    // everything referenced by one recorded frame, swapping two arenas swaps whole frames.
+    struct DrawArena
+    {
+        std::vector<DrawObject> objects;
+        std::vector<PoolState> states;
+        std::vector<TexturePtr> textures;
+        std::vector<std::function<void()>> actions;
+        std::vector<CoordsBuffer> coords;
+        uint32_t coordsCount{ 0 };
+
+        // TextureAtlas epoch the atlas placements were read at
+        uint32_t atlasEpoch{ 0 };
+
+        uint32_t addState(const PoolState& state) { states.emplace_back(state); return states.size() - 1; }
+        uint32_t addTexture(const TexturePtr& texture) { textures.emplace_back(texture); return textures.size() - 1; }
+        uint32_t addAction(const std::function<void()>& action) { actions.emplace_back(action); return actions.size() - 1; }
+        uint32_t acquireCoords() {
+            if (coordsCount == coords.size())
+                coords.emplace_back();
+            return coordsCount++;
+        }
+
+        void execute(DrawPool* pool, const DrawObject& obj) const;
+        void clear();
     };
 
+public:
+    // draw calls as they reached the pool, replaying them yields the same commands
+    // without walking the scene again. Commands share the pool state they were issued
+    // under, a new state is only stored when it differs from the previous command's.
+    struct DrawCommandList
+    {
+        struct Command
+        {
+            Color color;
+            TexturePtr texture;
+            DrawMethod method;
+            uint16_t state{ 0 };
+            DrawOrder order{ DrawOrder::FIRST };
+        };
+
+        struct State
+        {
+            PoolState state;
+            std::function<void()> shaderAction;
+        };
+
+        std::vector<Command> commands;
+        std::vector<State> states;
+
+        // method coordinates are replayed relative to this point
+        Point origin;
+
+        void clear() { commands.clear(); states.clear(); }
+    };
+
+protected:
     struct DrawObjectState
     {
         CompositionMode compositionMode{ CompositionMode::NORMAL };
@@ -187,6 +257,7 @@ private:
 
     static DrawPool* create(DrawPoolType type);
     static void addCoords(CoordsBuffer& buffer, const DrawMethod& method);
+    static Rect getBounds(const DrawMethod& method);
 
     enum STATE_TYPE : uint32_t
     {
@@ -200,6 +271,13 @@ private:
     void add(const Color& color, const TexturePtr& texture, DrawMethod&& method, const CoordsBufferPtr& coordsBuffer = nullptr);
 
     void addAction(const std::function<void()>& action, size_t hash = 0);
+
+    void beginCapture(DrawCommandList* commands, const Point& origin);
+    bool endCapture() { m_capture = nullptr; return m_captureValid; }
+    void invalidateCapture() { m_captureValid = false; }
+    void capture(const Color& color, const TexturePtr& texture, const DrawMethod& method, const CoordsBufferPtr& coordsBuffer);
+    void replay(const DrawCommandList& commands, const Point& origin);
+
     void bindFrameBuffer(const Size& size, const Color& color = Color::white);
     void releaseFrameBuffer(const Rect& dest);
 
@@ -207,6 +285,10 @@ private:
 
     bool updateHash(const DrawMethod& method, const Texture* texture, const Color& color, bool hasCoord);
     PoolState getState(const TexturePtr& texture, Texture* textureAtlas, const Color& color);
+    DrawObject& addDrawObject(std::vector<DrawObject>& list, const TexturePtr& texture, Texture* textureAtlas, const Color& color);
+    void appendObjects(std::vector<DrawObject>& dest, std::vector<DrawObject>& src);
+    void sortObjects(std::vector<DrawObject>& objects);
+    void sortObjects();
 
     PoolState& getCurrentState() { return m_states[m_lastStateIndex]; }
     const PoolState& getCurrentState() const { return m_states[m_lastStateIndex]; }
@@ -224,7 +306,7 @@ private:
 
     void resetOpacity() { getCurrentState().opacity = 1.f; }
     void resetClipRect() { getCurrentState().clipRect = {}; }
-    void resetShaderProgram() { getCurrentState().shaderProgram = nullptr; getCurrentState().action = nullptr; }
+    void resetShaderProgram() { getCurrentState().shaderProgram = nullptr; m_shaderActions[m_lastStateIndex] = nullptr; }
     void resetCompositionMode() { getCurrentState().compositionMode = CompositionMode::NORMAL; }
     void resetBlendEquation() { getCurrentState().blendEquation = BlendEquation::ADD; }
     void resetTransformMatrix() { getCurrentState().transformMatrix = DEFAULT_MATRIX3; }
@@ -238,8 +320,6 @@ private:
     void rotate(float x, float y, float angle);
     void rotate(const Point& p, const float angle) { rotate(p.x, p.y, angle); }
 
-    std::shared_ptr<CoordsBuffer> getCoordsBuffer();
-
     template<typename T>
     void setParameter(std::string_view name, T&& value) {
         m_parameters.emplace(name, value);
@@ -287,6 +367,7 @@ private:
 
     void nextStateAndReset() {
         m_states[++m_lastStateIndex] = {};
+        m_shaderActions[m_lastStateIndex] = nullptr;
     }
 
     void backState() {
@@ -297,6 +378,10 @@ private:
 
     bool m_enabled{ true };
     bool m_alwaysGroupDrawings{ false };
+    bool m_batchSorting{ false };
+    bool m_captureValid{ false };
+
+    DrawCommandList* m_capture{ nullptr };
 
     int_fast8_t m_bindedFramebuffers{ -1 };
 
@@ -305,6 +390,7 @@ private:
     uint_fast64_t m_lastFramebufferId{ 0 };
 
     PoolState m_states[10];
+    std::function<void()> m_shaderActions[10];
     uint_fast8_t m_lastStateIndex{ 0 };
 
     DrawPoolType m_type{ DrawPoolType::LAST };
@@ -317,12 +403,13 @@ private:
     std::vector<Matrix3> m_transformMatrixStack;
     std::vector<FrameBufferPtr> m_temporaryFramebuffers;
 
+    // draw orders and flushed objects record into m_recording, release() moves it into m_objectsDraw[0]
     std::vector<DrawObject> m_objects[static_cast<uint8_t>(LAST)];
     std::vector<DrawObject> m_objectsFlushed;
-    std::array<std::vector<DrawObject>, 2> m_objectsDraw;
-    std::vector<CoordsBuffer*> m_coordsCache;
+    DrawArena m_recording;
+    std::array<DrawArena, 2> m_objectsDraw;
 
-    stdext::map<size_t, CoordsBuffer*> m_coords;
+    stdext::map<size_t, uint32_t> m_coords;
     stdext::map<std::string_view, std::any> m_parameters;
 
     float m_scaleFactor{ 1.f };
@@ -338,6 +425,11 @@ private:
     TextureAtlasPtr m_atlas;
     std::atomic_bool m_shouldRepaint;
 
+    uint32_t m_batchCountBefore{ 0 };
+    uint32_t m_batchCountAfter{ 0 };
+    std::atomic_uint32_t m_batchCountBeforeSort{ 0 };
+    std::atomic_uint32_t m_batchCountAfterSort{ 0 };
+
     friend class DrawPoolManager;
 };
 
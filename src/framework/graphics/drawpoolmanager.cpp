@@ -41,6 +41,7 @@ void DrawPoolManager::init(const uint16_t spriteSize)
 
     auto atlasMap = std::make_shared<TextureAtlas>(Fw::TextureAtlasType::MAP, g_graphics.getMaxTextureSize());
     auto atlasForeground = std::make_shared<TextureAtlas>(Fw::TextureAtlasType::FOREGROUND, 2048, true);
+    m_atlases = { atlasMap, atlasForeground };
 
     // Create Pools
     for (int8_t i = -1; ++i < static_cast<uint8_t>(DrawPoolType::LAST);) {
@@ -62,8 +63,10 @@ void DrawPoolManager::init(const uint16_t spriteSize)
     }
 }
 
-void DrawPoolManager::terminate() const
+void DrawPoolManager::terminate()
 {
+    m_atlases.clear();
+
     // Destroy Pools
     for (int_fast8_t i = -1; ++i < static_cast<uint8_t>(DrawPoolType::LAST);) {
         delete m_pools[i];
@@ -86,18 +89,45 @@ void DrawPoolManager::draw()
     }
 
     for (int8_t i = -1; ++i < static_cast<uint8_t>(DrawPoolType::LAST);) {
+        const stdext::timer timer;
         drawPool(static_cast<DrawPoolType>(i));
+        m_drawDurations[i] = timer.elapsed_micros();
+    }
+
+    for (const auto& atlas : m_atlases) {
+        atlas->planCompactionIfIdle();
+        atlas->releaseRetiredLayers(getDrawnAtlasEpoch(atlas.get()));
+    }
+}
+
+void DrawPoolManager::applyAtlasCompactions()
+{
+    for (const auto& atlas : m_atlases) {
+        // an arena still waiting for the render thread was recorded against the current placements
+        const bool pending = std::ranges::any_of(m_pools, [&](const DrawPool* pool) {
+            return pool->m_atlas == atlas && pool->shouldRepaint();
+        });
+
+        if (pending || !atlas->applyCompaction())
+            continue;
+
+        // every pool sharing the atlas records again against the new placements
+        for (const auto pool : m_pools) {
+            if (pool->m_atlas == atlas)
+                pool->repaint();
+        }
     }
 }
 
-void DrawPoolManager::drawObject(DrawPool* pool, const DrawPool::DrawObject& obj)
+uint32_t DrawPoolManager::getDrawnAtlasEpoch(const TextureAtlas* atlas) const
 {
-    if (obj.action) {
-        obj.action();
-    } else if (obj.coords) {
-        obj.state.execute(pool);
-        g_painter->drawCoords(*obj.coords, DrawMode::TRIANGLES);
+    uint32_t epoch = atlas->getEpoch();
+    for (const auto pool : m_pools) {
+        const auto& arena = pool->m_objectsDraw[1];
+        if (pool->m_atlas.get() == atlas && !arena.objects.empty())
+            epoch = std::min(epoch, arena.atlasEpoch);
     }
+    return epoch;
 }
 
 void DrawPoolManager::addTexturedCoordsBuffer(const TexturePtr& texture, const CoordsBufferPtr& coords, const Color& color) const
@@ -216,6 +246,10 @@ void DrawPoolManager::drawObjects(DrawPool* pool) {
     if (!shouldRepaint && hasFramebuffer)
         return;
 
+    // regions moved by a compaction reach their new layers before any arena recorded against them runs
+    if (pool->m_atlas)
+        pool->m_atlas->flush();
+
     if (hasFramebuffer)
         pool->m_framebuffer->bind();
 
@@ -225,14 +259,16 @@ void DrawPoolManager::drawObjects(DrawPool* pool) {
         pool->m_shouldRepaint.store(false, std::memory_order_release);
     }
 
-    for (auto& obj : pool->m_objectsDraw[1]) {
-        drawObject(pool, obj);
+    const auto& arena = pool->m_objectsDraw[1];
+    for (const auto& obj : arena.objects) {
+        arena.execute(pool, obj);
     }
 
     if (hasFramebuffer) {
         pool->m_framebuffer->release();
     }
 
+    // textures added to the atlas while executing
     if (pool->m_atlas)
         pool->m_atlas->flush();
 }
@@ -254,6 +290,33 @@ void DrawPoolManager::drawPool(const DrawPoolType type) {
     }
 }
 
+std::map<std::string, double> DrawPoolManager::getAtlasReport() const {
+    std::map<std::string, double> report;
+
+    std::vector<const TextureAtlas*> atlases;
+    for (const auto pool : m_pools) {
+        if (pool->m_atlas && std::find(atlases.begin(), atlases.end(), pool->m_atlas.get()) == atlases.end())
+            atlases.emplace_back(pool->m_atlas.get());
+    }
+
+    for (const auto atlas : atlases) {
+        const std::string name = atlas->getType() == Fw::TextureAtlasType::MAP ? "map" : "foreground";
+        for (const bool smooth : { false, true }) {
+            const auto& stats = atlas->getStats(smooth);
+            if (stats.layers == 0)
+                continue;
+
+            const std::string prefix = smooth ? name + ".smooth." : name + ".";
+            report[prefix + "layers"] = stats.layers;
+            report[prefix + "freeRegions"] = stats.freeRegions;
+            report[prefix + "occupancy"] = stats.occupancy();
+            report[prefix + "fragmentation"] = stats.fragmentation();
+        }
+    }
+
+    return report;
+}
+
 void DrawPoolManager::removeTextureFromAtlas(uint32_t id, bool smooth) {
     for (auto pool : m_pools) {
         if (pool->m_atlas)
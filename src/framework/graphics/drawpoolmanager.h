@@ -54,6 +54,13 @@ public:
     void addBoundingRect(const Rect& dest, const Color& color = Color::white, uint16_t innerLineWidth = 1) const;
     void addAction(const std::function<void()>& action, size_t hash = 0) const { getCurrentPool()->addAction(action, hash); }
 
+    // records the draw calls issued until endCapture(), false if they can't be replayed;
+    // a replay moves the calls from the capture origin to the given one
+    void beginCapture(DrawPool::DrawCommandList* commands, const Point& origin) const { getCurrentPool()->beginCapture(commands, origin); }
+    bool endCapture() const { return getCurrentPool()->endCapture(); }
+    void invalidateCapture() const { if (isValid()) getCurrentPool()->invalidateCapture(); }
+    void replay(const DrawPool::DrawCommandList& commands, const Point& origin) const { getCurrentPool()->replay(commands, origin); }
+
     void bindFrameBuffer(const Size& size, const Color& color = Color::white) const { getCurrentPool()->bindFrameBuffer(size, color); }
     void releaseFrameBuffer(const Rect& dest) const { getCurrentPool()->releaseFrameBuffer(dest); };
 
@@ -110,20 +117,34 @@ public:
         get(drawPool)->repaint();
     }
 
+    void setBatchSorting(const DrawPoolType drawPool, const bool v) const { get(drawPool)->setBatchSorting(v); }
+    bool isBatchSorting(const DrawPoolType drawPool) const { return get(drawPool)->isBatchSorting(); }
+    uint32_t getBatchCountBeforeSort(const DrawPoolType drawPool) const { return get(drawPool)->getBatchCountBeforeSort(); }
+    uint32_t getBatchCountAfterSort(const DrawPoolType drawPool) const { return get(drawPool)->getBatchCountAfterSort(); }
+
     bool isPreDrawing() const;
 
+    // time the last draw() spent on the pool, in microseconds
+    uint32_t getDrawDuration(const DrawPoolType type) const { return m_drawDurations[static_cast<uint8_t>(type)]; }
+
     void removeTextureFromAtlas(uint32_t id, bool smooth);
 
+    // layers, free regions, occupancy and fragmentation of every atlas filter group in use
+    std::map<std::string, double> getAtlasReport() const;
+
 private:
     DrawPool* getCurrentPool() const;
 
     void draw();
     void init(uint16_t spriteSize);
-    void terminate() const;
-    void drawObject(DrawPool* pool, const DrawPool::DrawObject& obj);
+    void terminate();
     void drawPool(DrawPoolType type);
     void drawObjects(DrawPool* pool);
 
+    // map thread, between frames: moves atlas regions planned by the render thread
+    void applyAtlasCompactions();
+    uint32_t getDrawnAtlasEpoch(const TextureAtlas* atlas) const;
+
     inline bool isDrawing() const {
         for (auto pool : m_pools) {
             if (pool->isEnabled() && pool->shouldRepaint())
@@ -134,6 +155,8 @@ private:
     }
 
     std::array<DrawPool*, static_cast<uint8_t>(DrawPoolType::LAST)> m_pools{};
+    std::array<uint32_t, static_cast<uint8_t>(DrawPoolType::LAST)> m_drawDurations{};
+    std::vector<TextureAtlasPtr> m_atlases;
 
     Size m_size;
     Matrix3 m_transformMatrix;
@@ -30,6 +30,7 @@ FontManager g_fonts;
 void FontManager::terminate() { clearFonts(); }
 
 void FontManager::clearFonts() {
+    clearLayoutCache();
     m_fonts.clear();
     m_defaultFont = nullptr;
     m_defaultWidgetFont = nullptr;
@@ -43,6 +44,9 @@ bool FontManager::importFont(const std::string& file)
         const auto& fontNode = doc->at("Font");
         const auto& name = fontNode->valueAt("name");
 
+        // layouts are keyed by font address, drop them before a font may be replaced
+        clearLayoutCache();
+
         // remove any font with the same name
         for (auto it = m_fonts.begin(); it != m_fonts.end(); ++it) {
             if ((*it)->getName() == name) {
@@ -88,4 +92,130 @@ BitmapFontPtr FontManager::getFont(const std::string_view fontName)
     // when not found, fallback to default font
     g_logger.error("font '{}' not found", fontName);
     return m_defaultFont;
-}
\ No newline at end of file
+}
+void FontManager::setLayoutCacheLimit(const size_t entries)
+{
+    std::scoped_lock l(m_layoutCache.mutex);
+    m_layoutCache.limit = entries;
+    trimLayoutCache();
+}
+
+size_t FontManager::getLayoutCacheSize()
+{
+    std::scoped_lock l(m_layoutCache.mutex);
+    return m_layoutCache.lru.size();
+}
+
+void FontManager::clearLayoutCache()
+{
+    std::scoped_lock l(m_layoutCache.mutex);
+    m_layoutCache.lru.clear();
+    m_layoutCache.entries.clear();
+}
+
+std::map<std::string, uint64_t> FontManager::getLayoutCacheStats()
+{
+    std::scoped_lock l(m_layoutCache.mutex);
+    return {
+        { "hits", m_layoutCache.hits },
+        { "misses", m_layoutCache.misses },
+        { "evictions", m_layoutCache.evictions },
+        { "size", m_layoutCache.lru.size() },
+        { "limit", m_layoutCache.limit }
+    };
+}
+
+void FontManager::resetLayoutCacheStats()
+{
+    std::scoped_lock l(m_layoutCache.mutex);
+    m_layoutCache.hits = 0;
+    m_layoutCache.misses = 0;
+    m_layoutCache.evictions = 0;
+}
+
+size_t FontManager::getLayoutKey(const LayoutKind kind, const BitmapFont* font, const std::string_view text, const Fw::AlignmentFlag align, const Size& box)
+{
+    size_t key = std::hash<std::string_view>{}(text);
+    stdext::hash_combine(key, static_cast<int>(kind));
+    stdext::hash_combine(key, reinterpret_cast<uintptr_t>(font));
+    stdext::hash_combine(key, static_cast<int>(align));
+    stdext::hash_combine(key, box.width());
+    stdext::hash_combine(key, box.height());
+    return key;
+}
+
+FontManager::TextLayoutPtr FontManager::getGlyphsLayout(const BitmapFont* font, const std::string_view text, const Fw::AlignmentFlag align)
+{
+    return findLayout(LayoutKind::GLYPHS, font, text, align, {});
+}
+
+void FontManager::cacheGlyphsLayout(const BitmapFont* font, const std::string_view text, const Fw::AlignmentFlag align, TextLayoutPtr layout)
+{
+    storeLayout(LayoutKind::GLYPHS, font, text, align, {}, std::move(layout));
+}
+
+FontManager::TextLayoutPtr FontManager::getTextLayout(const BitmapFont* font, const std::string_view text, const Fw::AlignmentFlag align, const Size& box)
+{
+    return findLayout(LayoutKind::COORDS, font, text, align, box);
+}
+
+void FontManager::cacheTextLayout(const BitmapFont* font, const std::string_view text, const Fw::AlignmentFlag align, const Size& box, TextLayoutPtr layout)
+{
+    storeLayout(LayoutKind::COORDS, font, text, align, box, std::move(layout));
+}
+
+FontManager::TextLayoutPtr FontManager::findLayout(const LayoutKind kind, const BitmapFont* font, const std::string_view text, const Fw::AlignmentFlag align, const Size& box)
+{
+    if (text.size() > MAX_CACHED_TEXT_LENGTH)
+        return nullptr;
+
+    const size_t key = getLayoutKey(kind, font, text, align, box);
+
+    std::scoped_lock l(m_layoutCache.mutex);
+    const auto it = m_layoutCache.entries.find(key);
+    if (it == m_layoutCache.entries.end()) {
+        ++m_layoutCache.misses;
+        return nullptr;
+    }
+
+    const auto& entry = it->second->second;
+    if (entry.kind != kind || entry.font != font || entry.align != align || entry.box != box || entry.text != text) {
+        ++m_layoutCache.misses;
+        return nullptr;
+    }
+
+    ++m_layoutCache.hits;
+    m_layoutCache.lru.splice(m_layoutCache.lru.begin(), m_layoutCache.lru, it->second);
+    return entry.layout;
+}
+
+void FontManager::storeLayout(const LayoutKind kind, const BitmapFont* font, const std::string_view text, const Fw::AlignmentFlag align, const Size& box, TextLayoutPtr layout)
+{
+    if (text.size() > MAX_CACHED_TEXT_LENGTH)
+        return;
+
+    const size_t key = getLayoutKey(kind, font, text, align, box);
+
+    std::scoped_lock l(m_layoutCache.mutex);
+    if (m_layoutCache.limit == 0)
+        return;
+
+    // on a key collision the newest layout wins
+    if (const auto it = m_layoutCache.entries.find(key); it != m_layoutCache.entries.end()) {
+        m_layoutCache.lru.erase(it->second);
+        m_layoutCache.entries.erase(it);
+    }
+
+    m_layoutCache.lru.emplace_front(key, LayoutEntry{ kind, font, std::string(text), align, box, std::move(layout) });
+    m_layoutCache.entries.emplace(key, m_layoutCache.lru.begin());
+    trimLayoutCache();
+}
+
+void FontManager::trimLayoutCache()
+{
+    while (m_layoutCache.lru.size() > m_layoutCache.limit) {
+        m_layoutCache.entries.erase(m_layoutCache.lru.back().first);
+        m_layoutCache.lru.pop_back();
+        ++m_layoutCache.evictions;
+    }
+}
@@ -42,7 +42,63 @@ public:
     void setDefaultFont(const BitmapFontPtr& font) { m_defaultFont = font; }
     void setDefaultWidgetFont(const BitmapFontPtr& font) { m_defaultWidgetFont = font; }
 
+    // laid out texts of every font are kept in a LRU cache bounded by entry count, 0 disables it
+    void setLayoutCacheLimit(size_t entries);
+    size_t getLayoutCacheLimit() { return m_layoutCache.limit; }
+    size_t getLayoutCacheSize();
+    void clearLayoutCache();
+    std::map<std::string, uint64_t> getLayoutCacheStats();
+    void resetLayoutCacheStats();
+
+    struct TextLayout
+    {
+        std::vector<Point> glyphsPositions;
+        Size textBoxSize;
+        // glyph screen/texture rects relative to the text box, unclipped by atlas regions
+        std::vector<std::pair<Rect, Rect>> coords;
+    };
+    using TextLayoutPtr = std::shared_ptr<const TextLayout>;
+
+    // glyph layouts only hold glyph positions and the text box size
+    TextLayoutPtr getGlyphsLayout(const BitmapFont* font, std::string_view text, Fw::AlignmentFlag align);
+    void cacheGlyphsLayout(const BitmapFont* font, std::string_view text, Fw::AlignmentFlag align, TextLayoutPtr layout);
+
+    // text layouts hold the glyph rects clipped to a destination rect of the given size
+    TextLayoutPtr getTextLayout(const BitmapFont* font, std::string_view text, Fw::AlignmentFlag align, const Size& box);
+    void cacheTextLayout(const BitmapFont* font, std::string_view text, Fw::AlignmentFlag align, const Size& box, TextLayoutPtr layout);
+
+    static constexpr size_t MAX_CACHED_TEXT_LENGTH = 256;
+
 private:
+    enum class LayoutKind : uint8_t { GLYPHS, COORDS };
+
+    struct LayoutEntry
+    {
+        LayoutKind kind;
+        const BitmapFont* font;
+        std::string text;
+        Fw::AlignmentFlag align;
+        Size box;
+        TextLayoutPtr layout;
+    };
+
+    struct LayoutCache
+    {
+        std::mutex mutex;
+        std::list<std::pair<size_t, LayoutEntry>> lru; // most recently used first
+        stdext::map<size_t, std::list<std::pair<size_t, LayoutEntry>>::iterator> entries;
+        size_t limit{ 4096 };
+        uint64_t hits{ 0 };
+        uint64_t misses{ 0 };
+        uint64_t evictions{ 0 };
+    };
+
+    static size_t getLayoutKey(LayoutKind kind, const BitmapFont* font, std::string_view text, Fw::AlignmentFlag align, const Size& box);
+    TextLayoutPtr findLayout(LayoutKind kind, const BitmapFont* font, std::string_view text, Fw::AlignmentFlag align, const Size& box);
+    void storeLayout(LayoutKind kind, const BitmapFont* font, std::string_view text, Fw::AlignmentFlag align, const Size& box, TextLayoutPtr layout);
+    void trimLayoutCache();
+
+    LayoutCache m_layoutCache;
     std::vector<BitmapFontPtr> m_fonts;
     BitmapFontPtr m_defaultFont;
     BitmapFontPtr m_defaultWidgetFont;
@@ -33,6 +33,11 @@ uint32_t FrameBuffer::boundFbo = 0;
 
 FrameBuffer::FrameBuffer()
 {
+    if (g_graphics.isHeadless()) {
+        m_fbo = g_graphics.genNullObjectId();
+        return;
+    }
+
     glGenFramebuffers(1, &m_fbo);
     if (!m_fbo)
         g_logger.warning("Unable to create framebuffer object");
@@ -43,7 +48,7 @@ FrameBuffer::~FrameBuffer()
 #ifndef NDEBUG
     assert(!g_app.isTerminated());
 #endif
-    if (g_graphics.ok() && m_fbo != 0) {
+    if (g_graphics.ok() && m_fbo != 0 && !g_graphics.isHeadless()) {
         g_mainDispatcher.addEvent([id = m_fbo] {
             glDeleteFramebuffers(1, &id);
         });
@@ -65,6 +70,9 @@ bool FrameBuffer::resize(const Size& size)
     m_screenCoordsBuffer.clear();
     m_screenCoordsBuffer.addRect(Rect{ 0, 0, size });
 
+    if (g_graphics.isHeadless())
+        return true;
+
     internalBind();
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture->getId(), 0);
 
@@ -114,18 +122,19 @@ void FrameBuffer::release() const
 
 void FrameBuffer::draw()
 {
-    if (m_disableBlend) glDisable(GL_BLEND);
+    if (m_disableBlend) g_painter->setBlending(false);
     g_painter->setCompositionMode(m_compositeMode);
     g_painter->setTexture(m_texture);
     g_painter->drawCoords(m_coordsBuffer, DrawMode::TRIANGLE_STRIP);
     g_painter->resetCompositionMode();
-    if (m_disableBlend) glEnable(GL_BLEND);
+    if (m_disableBlend) g_painter->setBlending(true);
 }
 
 void FrameBuffer::internalBind()
 {
     assert(boundFbo != m_fbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    if (!g_graphics.isHeadless())
+        glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
     m_prevBoundFbo = boundFbo;
     boundFbo = m_fbo;
 }
@@ -133,7 +142,8 @@ void FrameBuffer::internalBind()
 void FrameBuffer::internalRelease() const
 {
     assert(boundFbo == m_fbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_prevBoundFbo);
+    if (!g_graphics.isHeadless())
+        glBindFramebuffer(GL_FRAMEBUFFER, m_prevBoundFbo);
     boundFbo = m_prevBoundFbo;
 }
 
@@ -165,7 +175,8 @@ TexturePtr FrameBuffer::extractTexture() {
     const int width = size.width();
     const int height = size.height();
     const auto& pixels = std::make_shared<std::vector<uint8_t>>(width * height * 4 * sizeof(GLubyte), 0);
-    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels->data());
+    if (!g_graphics.isHeadless())
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels->data());
     internalRelease();
 
     const auto& texture = std::make_shared<Texture>(std::make_shared<Image>(getSize(), 4, pixels->data()));
@@ -176,7 +187,7 @@ TexturePtr FrameBuffer::extractTexture() {
 
 void FrameBuffer::doScreenshot(std::string file, const uint16_t x, const uint16_t y)
 {
-    if (file.empty()) {
+    if (file.empty() || g_graphics.isHeadless()) {
         return;
     }
 
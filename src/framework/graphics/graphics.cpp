@@ -35,6 +35,22 @@ inline std::string_view glString(GLenum name) {
 
 void Graphics::init()
 {
+    if (m_headless) {
+        m_vendor = m_renderer = "null";
+        m_version = "0";
+        g_logger.info("GPU null painter (headless)");
+
+        if (m_maxTextureSize == -1)
+            m_maxTextureSize = 8192;
+
+        m_ok = true;
+
+        g_painter = std::make_unique<Painter>();
+
+        g_textures.init();
+        return;
+    }
+
     if (const auto* v = reinterpret_cast<const char*>(glGetString(GL_VENDOR)))
         m_vendor = v;
 
@@ -95,4 +111,26 @@ void Graphics::terminate()
     m_ok = false;
 }
 
-void Graphics::resize(const Size& size) { m_viewportSize = size; }
\ No newline at end of file
+void Graphics::resize(const Size& size) { m_viewportSize = size; }
+
+std::map<std::string, uint64_t> Graphics::getRenderStats() const
+{
+    return {
+        { "drawCalls", m_stats.drawCalls.load(std::memory_order_relaxed) },
+        { "vertices", m_stats.vertices.load(std::memory_order_relaxed) },
+        { "stateChanges", m_stats.stateChanges.load(std::memory_order_relaxed) },
+        { "clears", m_stats.clears.load(std::memory_order_relaxed) },
+        { "textureUploads", m_stats.textureUploads.load(std::memory_order_relaxed) },
+        { "uploadedBytes", m_stats.uploadedBytes.load(std::memory_order_relaxed) }
+    };
+}
+
+void Graphics::resetRenderStats()
+{
+    m_stats.drawCalls.store(0, std::memory_order_relaxed);
+    m_stats.vertices.store(0, std::memory_order_relaxed);
+    m_stats.stateChanges.store(0, std::memory_order_relaxed);
+    m_stats.clears.store(0, std::memory_order_relaxed);
+    m_stats.textureUploads.store(0, std::memory_order_relaxed);
+    m_stats.uploadedBytes.store(0, std::memory_order_relaxed);
+}
\ No newline at end of file
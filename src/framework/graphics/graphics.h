@@ -45,8 +45,44 @@ public:
 
     bool ok() const { return m_ok; }
 
+    // headless mode keeps the whole render path running without issuing GL calls,
+    // so the CPU cost of a frame can be measured on machines without a GPU.
+    // @dontbind
+    void setHeadless(const bool headless) { m_headless = headless; }
+    bool isHeadless() const { return m_headless; }
+
+    // stand-in names for textures and framebuffers created while headless
+    // @dontbind
+    uint32_t genNullObjectId() { return m_nullObjectId.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    // @dontbind
+    void addDrawCall(const uint32_t vertices) { m_stats.drawCalls.fetch_add(1, std::memory_order_relaxed); m_stats.vertices.fetch_add(vertices, std::memory_order_relaxed); }
+    // @dontbind
+    void addStateChange() { m_stats.stateChanges.fetch_add(1, std::memory_order_relaxed); }
+    // @dontbind
+    void addClear() { m_stats.clears.fetch_add(1, std::memory_order_relaxed); }
+    // @dontbind
+    void addTextureUpload(const uint64_t bytes) { m_stats.textureUploads.fetch_add(1, std::memory_order_relaxed); m_stats.uploadedBytes.fetch_add(bytes, std::memory_order_relaxed); }
+
+    std::map<std::string, uint64_t> getRenderStats() const;
+    void resetRenderStats();
+
 private:
+    struct RenderStats
+    {
+        std::atomic_uint64_t drawCalls{ 0 };
+        std::atomic_uint64_t vertices{ 0 };
+        std::atomic_uint64_t stateChanges{ 0 };
+        std::atomic_uint64_t clears{ 0 };
+        std::atomic_uint64_t textureUploads{ 0 };
+        std::atomic_uint64_t uploadedBytes{ 0 };
+    };
+
     bool m_ok{ false };
+    bool m_headless{ false };
+
+    std::atomic_uint32_t m_nullObjectId{ 0 };
+    RenderStats m_stats;
 
     std::string m_vendor;
     std::string m_renderer;
@@ -26,6 +26,14 @@
 #include "framework/core/filestream.h"
 #include "framework/core/resourcemanager.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMAGE_KERNELS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define IMAGE_KERNELS_NEON
+#endif
+
 using namespace qrcodegen;
 
 Image::Image(const Size& size, const int bpp, const uint8_t* pixels) : m_size(size), m_bpp(bpp)
@@ -93,44 +101,84 @@ void Image::savePNG(const std::string& fileName)
     fin->close();
 }
 
+// Pixel kernels work on whole RGBA words, compared and selected as native integers. Words
+// are built from the channel bytes, so they match the pixel memory on any byte order.
+static uint32_t loadPixel(const uint8_t* data) { uint32_t pixel; memcpy(&pixel, data, 4); return pixel; }
+static void storePixel(uint8_t* data, const uint32_t pixel) { memcpy(data, &pixel, 4); }
+static uint32_t toPixel(const uint8_t r, const uint8_t g, const uint8_t b, const uint8_t a)
+{
+    const uint8_t bytes[4] = { r, g, b, a };
+    return loadPixel(bytes);
+}
+static uint32_t toPixel(const Color& color) { return toPixel(color.r(), color.g(), color.b(), color.a()); }
+
+// four pixels at a time where SSE2 or NEON is available, the remaining pixels of a row or
+// image go through the word loop
+#if defined(IMAGE_KERNELS_SSE2)
+#define IMAGE_KERNELS_BLOCKS
+using PixelBlock = __m128i;
+static PixelBlock loadBlock(const uint8_t* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+static void storeBlock(uint8_t* data, const PixelBlock block) { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), block); }
+static PixelBlock splatPixel(const uint32_t pixel) { return _mm_set1_epi32(static_cast<int>(pixel)); }
+static PixelBlock equalPixels(const PixelBlock a, const PixelBlock b) { return _mm_cmpeq_epi32(a, b); }
+static PixelBlock selectPixels(const PixelBlock mask, const PixelBlock a, const PixelBlock b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+static PixelBlock andPixels(const PixelBlock a, const PixelBlock b) { return _mm_and_si128(a, b); }
+static PixelBlock orPixels(const PixelBlock a, const PixelBlock b) { return _mm_or_si128(a, b); }
+#elif defined(IMAGE_KERNELS_NEON)
+#define IMAGE_KERNELS_BLOCKS
+using PixelBlock = uint32x4_t;
+static PixelBlock loadBlock(const uint8_t* data) { return vreinterpretq_u32_u8(vld1q_u8(data)); }
+static void storeBlock(uint8_t* data, const PixelBlock block) { vst1q_u8(data, vreinterpretq_u8_u32(block)); }
+static PixelBlock splatPixel(const uint32_t pixel) { return vdupq_n_u32(pixel); }
+static PixelBlock equalPixels(const PixelBlock a, const PixelBlock b) { return vceqq_u32(a, b); }
+static PixelBlock selectPixels(const PixelBlock mask, const PixelBlock a, const PixelBlock b) { return vbslq_u32(mask, a, b); }
+static PixelBlock andPixels(const PixelBlock a, const PixelBlock b) { return vandq_u32(a, b); }
+static PixelBlock orPixels(const PixelBlock a, const PixelBlock b) { return vorrq_u32(a, b); }
+#endif
+
 void Image::overwriteMask(const Color& maskedColor, const Color& insideColor, const Color& outsideColor)
 {
     assert(m_bpp == 4);
 
-    for (int p = 0; p < getPixelCount(); ++p) {
-        uint8_t& r = m_pixels[p * 4 + 0];
-        uint8_t& g = m_pixels[p * 4 + 1];
-        uint8_t& b = m_pixels[p * 4 + 2];
-        uint8_t& a = m_pixels[p * 4 + 3];
+    const uint32_t masked = toPixel(maskedColor);
+    const uint32_t inside = toPixel(insideColor);
+    const uint32_t outside = toPixel(outsideColor);
 
-        Color pixelColor(r, g, b, a);
-        Color writeColor = (pixelColor == maskedColor) ? insideColor : outsideColor;
+    uint8_t* data = m_pixels.data();
+    const size_t count = getPixelCount();
+    size_t p = 0;
 
-        r = writeColor.r();
-        g = writeColor.g();
-        b = writeColor.b();
-        a = writeColor.a();
-    }
+#ifdef IMAGE_KERNELS_BLOCKS
+    const auto maskedBlock = splatPixel(masked);
+    const auto insideBlock = splatPixel(inside);
+    const auto outsideBlock = splatPixel(outside);
+    for (; p + 4 <= count; p += 4)
+        storeBlock(data + p * 4, selectPixels(equalPixels(loadBlock(data + p * 4), maskedBlock), insideBlock, outsideBlock));
+#endif
+
+    for (; p < count; ++p)
+        storePixel(data + p * 4, loadPixel(data + p * 4) == masked ? inside : outside);
 }
 
 void Image::overwrite(const Color& color)
 {
     assert(m_bpp == 4);
 
-    for (int p = 0; p < getPixelCount(); ++p) {
-        uint8_t& r = m_pixels[p * 4 + 0];
-        uint8_t& g = m_pixels[p * 4 + 1];
-        uint8_t& b = m_pixels[p * 4 + 2];
-        uint8_t& a = m_pixels[p * 4 + 3];
+    const uint32_t writeColor = toPixel(color);
 
-        Color pixelColor(r, g, b, a);
-        Color writeColor = (pixelColor == Color::alpha) ? Color::alpha : color;
+    uint8_t* data = m_pixels.data();
+    const size_t count = getPixelCount();
+    size_t p = 0;
 
-        r = writeColor.r();
-        g = writeColor.g();
-        b = writeColor.b();
-        a = writeColor.a();
-    }
+#ifdef IMAGE_KERNELS_BLOCKS
+    const auto zeroBlock = splatPixel(0);
+    const auto colorBlock = splatPixel(writeColor);
+    for (; p + 4 <= count; p += 4)
+        storeBlock(data + p * 4, selectPixels(equalPixels(loadBlock(data + p * 4), zeroBlock), zeroBlock, colorBlock));
+#endif
+
+    for (; p < count; ++p)
+        storePixel(data + p * 4, loadPixel(data + p * 4) == 0 ? 0 : writeColor);
 }
 
 void Image::blit(const Point& dest, const ImagePtr& other)
@@ -140,17 +188,32 @@ void Image::blit(const Point& dest, const ImagePtr& other)
     if (!other)
         return;
 
+    const int width = other->getWidth();
+    const int height = other->getHeight();
     const uint8_t* otherPixels = other->getPixelData();
-    for (int p = 0; p < other->getPixelCount(); ++p) {
-        const int x = p % other->getWidth();
-        const int y = p / other->getWidth();
-        const int pos = ((dest.y + y) * m_size.width() + (dest.x + x)) * 4;
-
-        if (otherPixels[p * 4 + 3] != 0) {
-            m_pixels[pos + 0] = otherPixels[p * 4 + 0];
-            m_pixels[pos + 1] = otherPixels[p * 4 + 1];
-            m_pixels[pos + 2] = otherPixels[p * 4 + 2];
-            m_pixels[pos + 3] = otherPixels[p * 4 + 3];
+
+#ifdef IMAGE_KERNELS_BLOCKS
+    const auto zeroBlock = splatPixel(0);
+    const auto alphaBlock = splatPixel(toPixel(0, 0, 0, 0xff));
+#endif
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* src = otherPixels + static_cast<size_t>(y) * width * 4;
+        uint8_t* dst = m_pixels.data() + (static_cast<size_t>(dest.y + y) * m_size.width() + dest.x) * 4;
+        int x = 0;
+
+        // fully transparent source pixels keep the destination
+#ifdef IMAGE_KERNELS_BLOCKS
+        for (; x + 4 <= width; x += 4) {
+            const auto pixels = loadBlock(src + x * 4);
+            const auto transparent = equalPixels(andPixels(pixels, alphaBlock), zeroBlock);
+            storeBlock(dst + x * 4, selectPixels(transparent, loadBlock(dst + x * 4), pixels));
+        }
+#endif
+
+        for (; x < width; ++x) {
+            const uint32_t pixel = loadPixel(src + x * 4);
+            storePixel(dst + x * 4, src[x * 4 + 3] != 0 ? pixel : loadPixel(dst + x * 4));
         }
     }
 }
@@ -162,17 +225,11 @@ void Image::paste(const ImagePtr& other)
     if (!other)
         return;
 
+    const size_t rowBytes = static_cast<size_t>(other->getWidth()) * 4;
     const uint8_t* otherPixels = other->getPixelData();
-    for (int p = 0; p < other->getPixelCount(); ++p) {
-        const int x = p % other->getWidth();
-        const int y = p / other->getWidth();
-        const int pos = (y * m_size.width() + x) * 4;
-
-        m_pixels[pos + 0] = otherPixels[p * 4 + 0];
-        m_pixels[pos + 1] = otherPixels[p * 4 + 1];
-        m_pixels[pos + 2] = otherPixels[p * 4 + 2];
-        m_pixels[pos + 3] = otherPixels[p * 4 + 3];
-    }
+
+    for (int y = 0, height = other->getHeight(); y < height; ++y)
+        memcpy(m_pixels.data() + static_cast<size_t>(y) * m_size.width() * 4, otherPixels + y * rowBytes, rowBytes);
 }
 
 bool Image::nextMipmap()
@@ -235,17 +292,35 @@ bool Image::nextMipmap()
 
 void Image::flipVertically()
 {
-    for (int line = 0, h = m_size.height(), w = m_size.width(); line != h / 2; ++line) {
-        std::swap_ranges(
-            m_pixels.begin() + 4 * w * line,
-            m_pixels.begin() + 4 * w * (line + 1),
-            m_pixels.begin() + 4 * w * (h - line - 1));
+    const size_t rowBytes = static_cast<size_t>(m_size.width()) * m_bpp;
+    std::vector<uint8_t> row(rowBytes);
+
+    for (int line = 0, h = m_size.height(); line < h / 2; ++line) {
+        uint8_t* top = m_pixels.data() + line * rowBytes;
+        uint8_t* bottom = m_pixels.data() + (h - line - 1) * rowBytes;
+        memcpy(row.data(), top, rowBytes);
+        memcpy(top, bottom, rowBytes);
+        memcpy(bottom, row.data(), rowBytes);
     }
 }
 
 void Image::setOpacity(const uint8_t v) {
-    for (size_t i = 3, s = m_pixels.size(); i < s; i += 4)
-        m_pixels[i] = v;
+    const uint32_t colorMask = toPixel(0xff, 0xff, 0xff, 0);
+    const uint32_t alpha = toPixel(0, 0, 0, v);
+
+    uint8_t* data = m_pixels.data();
+    const size_t count = m_pixels.size() / 4;
+    size_t p = 0;
+
+#ifdef IMAGE_KERNELS_BLOCKS
+    const auto colorMaskBlock = splatPixel(colorMask);
+    const auto alphaBlock = splatPixel(alpha);
+    for (; p + 4 <= count; p += 4)
+        storeBlock(data + p * 4, orPixels(andPixels(loadBlock(data + p * 4), colorMaskBlock), alphaBlock));
+#endif
+
+    for (; p < count; ++p)
+        storePixel(data + p * 4, (loadPixel(data + p * 4) & colorMask) | alpha);
 }
 
 void Image::reverseChannels()
@@ -22,6 +22,7 @@
 
 #include "painter.h"
 
+#include "graphics.h"
 #include "framework/graphics/texture.h"
 #include "framework/graphics/texturemanager.h"
 #include "shader/shadersources.h"
@@ -34,10 +35,13 @@ std::unique_ptr<Painter> g_painter = nullptr;
    * compatible with OpenGL ES 2.0. Only recent cards support
    * this painter engine.
    */
-Painter::Painter()
+Painter::Painter() : m_headless(g_graphics.isHeadless())
 {
     setResolution(g_window.getSize());
 
+    if (m_headless)
+        return;
+
     const auto& getProgram = [](const std::string_view vertexSourceCode, const std::string_view fragmentSourceCode) {
         auto program = std::make_shared<PainterShaderProgram>();
         assert(program);
@@ -71,6 +75,10 @@ void Painter::drawCoords(const CoordsBuffer& coordsBuffer, DrawMode drawMode)
     if (coordsBuffer.getTextureCoordCount() > 0 && m_glTextureId == 0)
         return;
 
+    g_graphics.addDrawCall(vertexCount);
+    if (m_headless)
+        return;
+
     const bool textured = coordsBuffer.getTextureCoordCount() > 0 && m_glTextureId > 0;
 
     m_drawProgram = m_shaderProgram ? m_shaderProgram : textured ? m_drawTexturedProgram.get() : m_drawSolidColorProgram.get();
@@ -88,12 +96,12 @@ void Painter::drawCoords(const CoordsBuffer& coordsBuffer, DrawMode drawMode)
     if (textured) {
         m_drawProgram->setTextureMatrix(m_textureMatrix);
         m_drawProgram->bindMultiTextures();
-        m_drawProgram->setAttributeArray(PainterShaderProgram::TEXCOORD_ATTR, coordsBuffer.getTextureCoordArray(), 2);
+        m_drawProgram->setAttributeArray(PainterShaderProgram::TEXCOORD_ATTR, coordsBuffer.getTextureCoordArray(), 2, CoordsBuffer::STRIDE);
     } else
         PainterShaderProgram::disableAttributeArray(PainterShaderProgram::TEXCOORD_ATTR);
 
     // set vertex array
-    m_drawProgram->setAttributeArray(PainterShaderProgram::VERTEX_ATTR, coordsBuffer.getVertexArray(), 2);
+    m_drawProgram->setAttributeArray(PainterShaderProgram::VERTEX_ATTR, coordsBuffer.getVertexArray(), 2, CoordsBuffer::STRIDE);
 
     // draw the element in coords buffers
     glDrawArrays(static_cast<GLenum>(drawMode), 0, vertexCount);
@@ -104,6 +112,10 @@ void Painter::drawCoords(const CoordsBuffer& coordsBuffer, DrawMode drawMode)
 
 void Painter::drawLine(const std::vector<float>& vertex, const int size, const int width) const
 {
+    g_graphics.addDrawCall(size);
+    if (m_headless)
+        return;
+
     m_drawLineProgram->bind();
     m_drawLineProgram->setTransformMatrix(m_transformMatrix);
     m_drawLineProgram->setProjectionMatrix(m_projectionMatrix);
@@ -148,6 +160,10 @@ void Painter::refreshState() const {
 
 void Painter::clear(const Color& color)
 {
+    g_graphics.addClear();
+    if (m_headless)
+        return;
+
     glClearColor(color.rF(), color.gF(), color.bF(), color.aF());
     glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -156,8 +172,11 @@ void Painter::clearRect(const Color& color, const Rect& rect)
 {
     const auto& oldClipRect = m_clipRect;
     setClipRect(rect);
-    glClearColor(color.rF(), color.gF(), color.bF(), color.aF());
-    glClear(GL_COLOR_BUFFER_BIT);
+    g_graphics.addClear();
+    if (!m_headless) {
+        glClearColor(color.rF(), color.gF(), color.bF(), color.aF());
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
     setClipRect(oldClipRect);
 }
 
@@ -179,6 +198,16 @@ void Painter::setBlendEquation(const BlendEquation blendEquation)
     updateGlBlendEquation();
 }
 
+void Painter::setBlending(const bool enable) const
+{
+    g_graphics.addStateChange();
+    if (m_headless)
+        return;
+
+    if (enable) glEnable(GL_BLEND);
+    else glDisable(GL_BLEND);
+}
+
 void Painter::setClipRect(const Rect& clipRect)
 {
     if (m_clipRect == clipRect)
@@ -249,6 +278,10 @@ Matrix3 Painter::getTransformMatrix(const Size& resolution) const
 
 void Painter::updateGlCompositionMode() const
 {
+    g_graphics.addStateChange();
+    if (m_headless)
+        return;
+
     switch (m_compositionMode) {
         case CompositionMode::NORMAL:
             glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE);
@@ -273,6 +306,10 @@ void Painter::updateGlCompositionMode() const
 
 void Painter::updateGlClipRect() const
 {
+    g_graphics.addStateChange();
+    if (m_headless)
+        return;
+
     if (m_clipRect.isValid()) {
         glEnable(GL_SCISSOR_TEST);
         glScissor(m_clipRect.left(), m_resolution.height() - m_clipRect.bottom() - 1, m_clipRect.width(), m_clipRect.height());
@@ -281,7 +318,33 @@ void Painter::updateGlClipRect() const
         glDisable(GL_SCISSOR_TEST);
     }
 }
-void Painter::updateGlTexture() const { if (m_glTextureId != 0) glBindTexture(GL_TEXTURE_2D, m_glTextureId); }
-void Painter::updateGlBlendEquation() const { glBlendEquation(static_cast<GLenum>(m_blendEquation)); }
-void Painter::updateGlAlphaWriting() const { glColorMask(1, 1, 1, m_alphaWriting); }
-void Painter::updateGlViewport() const { glViewport(0, 0, m_resolution.width(), m_resolution.height()); }
\ No newline at end of file
+void Painter::updateGlTexture() const
+{
+    if (m_glTextureId == 0)
+        return;
+
+    g_graphics.addStateChange();
+    if (!m_headless)
+        glBindTexture(GL_TEXTURE_2D, m_glTextureId);
+}
+
+void Painter::updateGlBlendEquation() const
+{
+    g_graphics.addStateChange();
+    if (!m_headless)
+        glBlendEquation(static_cast<GLenum>(m_blendEquation));
+}
+
+void Painter::updateGlAlphaWriting() const
+{
+    g_graphics.addStateChange();
+    if (!m_headless)
+        glColorMask(1, 1, 1, m_alphaWriting);
+}
+
+void Painter::updateGlViewport() const
+{
+    g_graphics.addStateChange();
+    if (!m_headless)
+        glViewport(0, 0, m_resolution.width(), m_resolution.height());
+}
\ No newline at end of file
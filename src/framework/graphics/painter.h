@@ -65,6 +65,7 @@ public:
     void setShaderProgram(PainterShaderProgram* shaderProgram) { m_shaderProgram = shaderProgram; }
     void setShaderProgram(const PainterShaderProgramPtr& shaderProgram) { setShaderProgram(shaderProgram.get()); }
     void setCompositionMode(CompositionMode compositionMode);
+    void setBlending(bool enable) const;
 
     void setTextureMatrix(const Matrix3* matrix) { if (m_textureMatrix != matrix) m_textureMatrix = matrix; }
     void setTransformMatrix(const Matrix3& matrix) { if (m_transformMatrix != matrix) m_transformMatrix = matrix; }
@@ -95,6 +96,9 @@ protected:
     Matrix3 m_projectionMatrix;
     const Matrix3* m_textureMatrix = nullptr;
 
+    // null painter: keeps state and counters but never touches GL
+    bool m_headless{ false };
+
     BlendEquation m_blendEquation{ BlendEquation::ADD };
     bool m_alphaWriting{ false };
     uint32_t m_glTextureId{ 0 };
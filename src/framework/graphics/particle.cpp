@@ -24,79 +24,183 @@
 
 #include "animatedtexture.h"
 #include "drawpoolmanager.h"
+#include "particletype.h"
 
-void Particle::render() const
+void ParticleBuffer::spawn(const ParticleTypePtr& type, const PointF& position, const Size& startSize, const Size& finalSize,
+                           const PointF& velocity, const PointF& acceleration, const float duration)
 {
-    if (!m_texture) {
-        g_drawPool.addFilledRect(m_rect, m_color);
-        return;
-    }
+    size_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = m_alive.size();
+
+        const size_t capacity = slot + 1;
+        for (auto* values : { &positionX, &positionY, &velocityX, &velocityY, &accelerationX, &accelerationY,
+                              &m_age, &m_duration, &m_ignorePhysicsAfter })
+            values->resize(capacity);
 
-    g_drawPool.setCompositionMode(m_compositionMode, true);
-    if (m_animatedTexture) {
-        const auto& frame = m_animatedTexture->getCurrentFrame();
-        if (frame)
-            g_drawPool.addTexturedRect(m_rect, frame, m_color);
-        return;
+        m_startSize.resize(capacity);
+        m_finalSize.resize(capacity);
+        m_size.resize(capacity);
+        m_color.resize(capacity);
+        m_colorIndex.resize(capacity);
+        m_type.resize(capacity);
+        m_alive.resize(capacity);
     }
-    g_drawPool.addTexturedRect(m_rect, m_texture, m_color);
+
+    positionX[slot] = position.x;
+    positionY[slot] = position.y;
+    velocityX[slot] = velocity.x;
+    velocityY[slot] = velocity.y;
+    accelerationX[slot] = acceleration.x;
+    accelerationY[slot] = acceleration.y;
+
+    m_age[slot] = 0.f;
+    m_duration[slot] = duration;
+    m_ignorePhysicsAfter[slot] = type->pIgnorePhysicsAfter;
+    m_startSize[slot] = startSize;
+    m_finalSize[slot] = finalSize;
+    m_size[slot] = startSize;
+    m_color[slot] = Color::white;
+    m_colorIndex[slot] = 0;
+    m_type[slot] = getTypeIndex(type);
+    m_alive[slot] = 1;
 }
 
-void Particle::update(const float elapsedTime)
+void ParticleBuffer::release(const size_t slot)
 {
-    // check if finished
-    if (m_duration >= 0 && m_elapsedTime >= m_duration) {
-        m_finished = true;
-        return;
-    }
+    m_alive[slot] = 0;
+    m_freeSlots.emplace_back(static_cast<uint32_t>(slot));
+}
+
+void ParticleBuffer::clear()
+{
+    for (auto* values : { &positionX, &positionY, &velocityX, &velocityY, &accelerationX, &accelerationY,
+                          &m_age, &m_duration, &m_ignorePhysicsAfter })
+        values->clear();
 
-    if (m_animatedTexture)
-        m_animatedTexture->update();
+    m_startSize.clear();
+    m_finalSize.clear();
+    m_size.clear();
+    m_color.clear();
+    m_colorIndex.clear();
+    m_type.clear();
+    m_alive.clear();
+    m_freeSlots.clear();
+    m_types.clear();
+}
 
-    updateColor();
-    updateSize();
-    updatePosition(elapsedTime);
+uint16_t ParticleBuffer::getTypeIndex(const ParticleTypePtr& type)
+{
+    for (size_t i = 0; i < m_types.size(); ++i) {
+        if (m_types[i] == type)
+            return static_cast<uint16_t>(i);
+    }
 
-    m_elapsedTime += elapsedTime;
+    m_types.emplace_back(type);
+    return static_cast<uint16_t>(m_types.size() - 1);
 }
 
-void Particle::updatePosition(const float elapsedTime)
+void ParticleBuffer::update(const float elapsedTime)
 {
-    if (m_ignorePhysicsAfter < 0 || m_elapsedTime < m_ignorePhysicsAfter) {
-        // update position
-        PointF delta = m_velocity * elapsedTime;
-        delta.y *= -1; // painter orientate Y axis in the inverse direction
+    // animations are shared by every particle of a type, advance them once per step
+    for (const auto& type : m_types) {
+        if (type->pAnimatedTexture)
+            type->pAnimatedTexture->update();
+    }
 
-        const auto& position = m_position + delta;
+    for (size_t slot = 0, size = m_alive.size(); slot < size; ++slot) {
+        if (!m_alive[slot])
+            continue;
 
-        if (m_position != position) {
-            m_position += delta;
+        if (m_duration[slot] >= 0 && m_age[slot] >= m_duration[slot]) {
+            release(slot);
+            continue;
         }
 
-        // update acceleration
-        m_velocity += m_acceleration * elapsedTime;
+        updateVisuals(slot);
     }
 
-    m_rect.move(static_cast<int>(m_position.x) - m_size.width() / 2, static_cast<int>(m_position.y) - m_size.height() / 2);
+    integrate(elapsedTime);
 }
 
-void Particle::updateSize()
+void ParticleBuffer::integrate(const float elapsedTime)
 {
-    m_size = m_startSize + (m_finalSize - m_startSize) / m_duration * m_elapsedTime;
-    m_rect.resize(m_size);
+    const size_t size = m_alive.size();
+
+    float* __restrict posX = positionX.data();
+    float* __restrict posY = positionY.data();
+    float* __restrict velX = velocityX.data();
+    float* __restrict velY = velocityY.data();
+    const float* __restrict accX = accelerationX.data();
+    const float* __restrict accY = accelerationY.data();
+    float* __restrict age = m_age.data();
+    const float* __restrict ignorePhysicsAfter = m_ignorePhysicsAfter.data();
+
+    // branch free so the compiler can vectorize it; dead slots are stepped too, their values are never read
+    for (size_t i = 0; i < size; ++i) {
+        const float step = (ignorePhysicsAfter[i] < 0 || age[i] < ignorePhysicsAfter[i]) ? elapsedTime : 0.f;
+
+        posX[i] += velX[i] * step;
+        posY[i] -= velY[i] * step; // painter orientate Y axis in the inverse direction
+        velX[i] += accX[i] * step;
+        velY[i] += accY[i] * step;
+        age[i] += elapsedTime;
+    }
 }
 
-void Particle::updateColor()
+void ParticleBuffer::updateVisuals(const size_t slot)
 {
-    const float currentLife = m_elapsedTime / m_duration;
-    if (currentLife < m_colorsStops[1]) {
-        const float range = m_colorsStops[1] - m_colorsStops[0];
-        const float factor = (currentLife - m_colorsStops[0]) / range;
-        m_color = m_colors[0] * (1.0f - factor) + m_colors[1] * factor;
-    } else if (m_colors.size() > 1) {
-        m_colors.erase(m_colors.begin());
-        m_colorsStops.erase(m_colorsStops.begin());
-    } else if (m_color != m_colors[0]) {
-        m_color = m_colors[0];
+    const auto& type = *m_types[m_type[slot]];
+    const float age = m_age[slot];
+    const float duration = m_duration[slot];
+
+    m_size[slot] = m_startSize[slot] + (m_finalSize[slot] - m_startSize[slot]) / duration * age;
+
+    const auto& colors = type.pColors;
+    const auto& colorsStops = type.pColorsStops;
+    auto& colorIndex = m_colorIndex[slot];
+
+    if (colorIndex + 1u < colors.size()) {
+        const float currentLife = age / duration;
+        if (currentLife < colorsStops[colorIndex + 1]) {
+            const float range = colorsStops[colorIndex + 1] - colorsStops[colorIndex];
+            const float factor = (currentLife - colorsStops[colorIndex]) / range;
+            m_color[slot] = colors[colorIndex] * (1.0f - factor) + colors[colorIndex + 1] * factor;
+        } else {
+            ++colorIndex;
+        }
+    } else {
+        m_color[slot] = colors[colorIndex];
     }
-}
\ No newline at end of file
+}
+
+void ParticleBuffer::render() const
+{
+    for (size_t slot = 0, size = m_alive.size(); slot < size; ++slot) {
+        if (!m_alive[slot])
+            continue;
+
+        const auto& type = *m_types[m_type[slot]];
+        const auto& particleSize = m_size[slot];
+        const auto& color = m_color[slot];
+        const Rect rect(static_cast<int>(positionX[slot]) - particleSize.width() / 2,
+                        static_cast<int>(positionY[slot]) - particleSize.height() / 2, particleSize);
+
+        if (!type.pTexture) {
+            g_drawPool.addFilledRect(rect, color);
+            continue;
+        }
+
+        g_drawPool.setCompositionMode(type.pCompositionMode, true);
+        if (type.pAnimatedTexture) {
+            if (const auto& frame = type.pAnimatedTexture->getCurrentFrame())
+                g_drawPool.addTexturedRect(rect, frame, color);
+            continue;
+        }
+
+        g_drawPool.addTexturedRect(rect, type.pTexture, color);
+    }
+}
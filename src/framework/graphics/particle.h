@@ -23,64 +23,47 @@
 #pragma once
 
 #include "declarations.h"
-#include "painter.h"
-#include <framework/core/timer.h>
 
-class Particle
+// Particles of a system stored as parallel arrays. Slots of finished particles
+// go to a free list and are reused by the emitters, so a warmed up system does
+// not allocate; visual data (colors, textures) stays in the shared ParticleType.
+class ParticleBuffer
 {
 public:
-    Particle(const Point& pos, const Size& startSize, const Size& finalSize, const PointF& velocity,
-                       const PointF& acceleration, const float duration, const float ignorePhysicsAfter, const std::vector<Color>& colors,
-                       const std::vector<float>& colorsStops, const CompositionMode compositionMode, TexturePtr texture,
-                       AnimatedTexturePtr animatedTexture) :
-        m_colors(colors), m_colorsStops(colorsStops), m_texture(std::move(texture)), m_animatedTexture(std::move(
-        animatedTexture)), m_position(PointF(pos.x, pos.y)),
-        m_velocity(velocity), m_acceleration(acceleration), m_startSize(startSize), m_finalSize(finalSize),
-        m_duration(duration), m_ignorePhysicsAfter(ignorePhysicsAfter), m_compositionMode(compositionMode)
-    {
-    }
+    void spawn(const ParticleTypePtr& type, const PointF& position, const Size& startSize, const Size& finalSize,
+               const PointF& velocity, const PointF& acceleration, float duration);
 
-    void render() const;
     void update(float elapsedTime);
+    void render() const;
+    void clear();
 
-    bool hasFinished() const { return m_finished; }
-
-    PointF getPosition() { return m_position; }
-    PointF getVelocity() { return m_velocity; }
+    size_t capacity() const { return m_alive.size(); }
+    size_t count() const { return m_alive.size() - m_freeSlots.size(); }
+    bool empty() const { return count() == 0; }
 
-    void setPosition(const PointF& position) { m_position = position; }
-    void setVelocity(const PointF& velocity) { m_velocity = velocity; }
+    // state arrays, indexed by slot; dead slots hold stale values and are skipped by m_alive
+    std::vector<float> positionX, positionY;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> accelerationX, accelerationY;
 
 private:
-    void updateColor();
-    void updatePosition(float elapsedTime);
-    void updateSize();
-
-    std::vector<Color> m_colors;
-    std::vector<float> m_colorsStops;
-
-    TexturePtr m_texture;
-    AnimatedTexturePtr m_animatedTexture;
-
-    PointF m_position;
-    PointF m_velocity;
-    PointF m_acceleration;
-
-    Rect m_rect;
-
-    Color m_color;
-
-    Size m_size;
-    Size m_startSize;
-    Size m_finalSize;
-
-    Timer m_animationTimer;
-
-    float m_duration;
-    float m_ignorePhysicsAfter;
-    float m_elapsedTime{ 0 };
-
-    CompositionMode m_compositionMode;
-
-    bool m_finished{ false };
+    void release(size_t slot);
+    uint16_t getTypeIndex(const ParticleTypePtr& type);
+
+    void integrate(float elapsedTime);
+    void updateVisuals(size_t slot);
+
+    std::vector<float> m_age;
+    std::vector<float> m_duration;
+    std::vector<float> m_ignorePhysicsAfter;
+    std::vector<Size> m_startSize;
+    std::vector<Size> m_finalSize;
+    std::vector<Size> m_size;
+    std::vector<Color> m_color;
+    std::vector<uint16_t> m_colorIndex;
+    std::vector<uint16_t> m_type;
+    std::vector<uint8_t> m_alive;
+
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<ParticleTypePtr> m_types;
 };
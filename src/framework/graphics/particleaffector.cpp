@@ -77,14 +77,20 @@ void GravityAffector::load(const OTMLNodePtr& node)
     }
 }
 
-void GravityAffector::updateParticle(const ParticlePtr& particle, const float elapsedTime) const
+void GravityAffector::updateParticles(ParticleBuffer& particles, const float elapsedTime) const
 {
     if (!m_active)
         return;
 
-    PointF velocity = particle->getVelocity();
-    velocity += PointF(m_gravity * elapsedTime * std::cos(m_angle), m_gravity * elapsedTime * std::sin(m_angle));
-    particle->setVelocity(velocity);
+    const float deltaX = m_gravity * elapsedTime * std::cos(m_angle);
+    const float deltaY = m_gravity * elapsedTime * std::sin(m_angle);
+
+    float* __restrict velocityX = particles.velocityX.data();
+    float* __restrict velocityY = particles.velocityY.data();
+    for (size_t i = 0, size = particles.capacity(); i < size; ++i) {
+        velocityX[i] += deltaX;
+        velocityY[i] += deltaY;
+    }
 }
 
 void AttractionAffector::load(const OTMLNodePtr& node)
@@ -107,17 +113,27 @@ void AttractionAffector::load(const OTMLNodePtr& node)
     }
 }
 
-void AttractionAffector::updateParticle(const ParticlePtr& particle, const float elapsedTime) const
+void AttractionAffector::updateParticles(ParticleBuffer& particles, const float elapsedTime) const
 {
     if (!m_active)
         return;
 
-    const auto& pPosition = particle->getPosition();
-    const auto& d = PointF(m_position.x - pPosition.x, pPosition.y - m_position.y);
-    if (d.length() == 0)
-        return;
+    const float pull = (m_repelish ? -m_acceleration : m_acceleration) * elapsedTime;
+    const float keep = 1.f - m_reduction / 100.f * elapsedTime;
 
-    const auto& direction = m_repelish ? PointF(-1, -1) : PointF(1, 1);
-    const auto& pVelocity = particle->getVelocity() + (d / d.length() * m_acceleration * elapsedTime) * direction;
-    particle->setVelocity(pVelocity - pVelocity * m_reduction / 100.f * elapsedTime);
+    const float* __restrict positionX = particles.positionX.data();
+    const float* __restrict positionY = particles.positionY.data();
+    float* __restrict velocityX = particles.velocityX.data();
+    float* __restrict velocityY = particles.velocityY.data();
+
+    for (size_t i = 0, size = particles.capacity(); i < size; ++i) {
+        const float dx = m_position.x - positionX[i];
+        const float dy = positionY[i] - m_position.y;
+        const float length = std::sqrt(dx * dx + dy * dy);
+        if (length == 0)
+            continue;
+
+        velocityX[i] = (velocityX[i] + dx / length * pull) * keep;
+        velocityY[i] = (velocityY[i] + dy / length * pull) * keep;
+    }
 }
\ No newline at end of file
@@ -32,7 +32,7 @@ public:
 
     void update(float elapsedTime);
     virtual void load(const OTMLNodePtr& node);
-    virtual void updateParticle(const ParticlePtr&, float) const = 0;
+    virtual void updateParticles(ParticleBuffer& particles, float elapsedTime) const = 0;
 
     bool hasFinished() const { return m_finished; }
 
@@ -48,7 +48,7 @@ class GravityAffector final : public ParticleAffector
 {
 public:
     void load(const OTMLNodePtr& node) override;
-    void updateParticle(const ParticlePtr& particle, float elapsedTime) const override;
+    void updateParticles(ParticleBuffer& particles, float elapsedTime) const override;
 
 private:
     float m_angle{ 0 };
@@ -59,7 +59,7 @@ class AttractionAffector final : public ParticleAffector
 {
 public:
     void load(const OTMLNodePtr& node) override;
-    void updateParticle(const ParticlePtr& particle, float elapsedTime) const override;
+    void updateParticles(ParticleBuffer& particles, float elapsedTime) const override;
 
 private:
     Point m_position;
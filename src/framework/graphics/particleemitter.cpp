@@ -22,7 +22,6 @@
 
 #include "particleemitter.h"
 
-#include "particle.h"
 #include "particlemanager.h"
 #include "particlesystem.h"
 #include "particletype.h"
@@ -73,7 +72,7 @@ void ParticleEmitter::update(const float elapsedTime, const ParticleSystemPtr& s
         const float pRadius = stdext::random_range(type->pMinPositionRadius, type->pMaxPositionRadius);
         const float pAngle = stdext::random_range(type->pMinPositionAngle, type->pMaxPositionAngle);
 
-        Point pPosition = m_position + Point(pRadius * std::cos(pAngle), pRadius * std::sin(pAngle));
+        const Point pPosition = m_position + Point(pRadius * std::cos(pAngle), pRadius * std::sin(pAngle));
 
         for (int p = 0; p < m_burstCount; ++p) {
             const float pDuration = stdext::random_range(type->pMinDuration, type->pMaxDuration);
@@ -89,14 +88,11 @@ void ParticleEmitter::update(const float elapsedTime, const ParticleSystemPtr& s
             const PointF pAcceleration(pAccelerationAbs * std::cos(pAccelerationAngle), pAccelerationAbs * std::sin(pAccelerationAngle));
 
             const float multiplier = stdext::random_range(type->pRandomSizeMultiplier.x, type->pRandomSizeMultiplier.y);
-            Size startSize = type->pStartSize * multiplier;
-            Size finalSize = type->pFinalSize * multiplier;
-
-            system->addParticle(std::make_shared<Particle>(pPosition, startSize, finalSize,
-                                pVelocity, pAcceleration,
-                                pDuration, type->pIgnorePhysicsAfter,
-                                type->pColors, type->pColorsStops,
-                                type->pCompositionMode, type->pTexture, type->pAnimatedTexture));
+            const Size startSize = type->pStartSize * multiplier;
+            const Size finalSize = type->pFinalSize * multiplier;
+
+            system->spawnParticle(m_particleType, PointF(pPosition.x, pPosition.y), startSize, finalSize,
+                                  pVelocity, pAcceleration, pDuration);
         }
     }
 
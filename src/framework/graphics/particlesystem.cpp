@@ -22,7 +22,6 @@
 
 #include "particlesystem.h"
 #include "drawpoolmanager.h"
-#include "particle.h"
 #include "particleaffector.h"
 #include "particleemitter.h"
 #include "framework/core/clock.h"
@@ -52,14 +51,14 @@ void ParticleSystem::load(const OTMLNodePtr& node)
     }
 }
 
-void ParticleSystem::addParticle(const ParticlePtr& particle) { m_particles.emplace_back(particle); }
-
-void ParticleSystem::render() const
+void ParticleSystem::spawnParticle(const ParticleTypePtr& type, const PointF& position, const Size& startSize, const Size& finalSize,
+                                   const PointF& velocity, const PointF& acceleration, const float duration)
 {
-    for (const auto& particle : m_particles)
-        particle->render();
+    m_particles.spawn(type, position, startSize, finalSize, velocity, acceleration, duration);
 }
 
+void ParticleSystem::render() const { m_particles.render(); }
+
 void ParticleSystem::update()
 {
     static constexpr float delay = 0.0166; // 60 updates/s
@@ -101,20 +100,11 @@ void ParticleSystem::update()
             }
         }
 
-        // update particles
-        for (auto it = m_particles.begin(); it != m_particles.end();) {
-            const ParticlePtr& particle = *it;
-            if (particle->hasFinished()) {
-                it = m_particles.erase(it);
-            } else {
-                // pass particles through affectors
-                for (const auto& particleAffector : m_affectors)
-                    particleAffector->updateParticle(particle, delay);
+        // pass particles through affectors, then step them
+        for (const auto& affector : m_affectors)
+            affector->updateParticles(m_particles, delay);
 
-                particle->update(delay);
-                ++it;
-            }
-        }
+        m_particles.update(delay);
     }
 
     g_drawPool.repaint(DrawPoolType::FOREGROUND);
@@ -22,6 +22,7 @@
 
 #include "shadermanager.h"
 
+#include "graphics.h"
 #include "paintershaderprogram.h"
 #include "framework/core/eventdispatcher.h"
 #include "framework/core/resourcemanager.h"
@@ -46,6 +47,10 @@ void ShaderManager::putShader(std::string name, const PainterShaderProgramPtr& s
 
 void ShaderManager::createShader(const std::string_view name, bool useFramebuffer)
 {
+    // the null painter has no programs, callers already cope with a missing shader
+    if (g_graphics.isHeadless())
+        return;
+
     g_mainDispatcher.addEvent([this, name = name.data(), useFramebuffer] {
         const auto& shader = std::make_shared<PainterShaderProgram>();
         shader->setUseFramebuffer(useFramebuffer);
@@ -56,6 +61,9 @@ void ShaderManager::createShader(const std::string_view name, bool useFramebuffe
 
 void ShaderManager::createFragmentShader(const std::string_view name, const std::string_view file, bool useFramebuffer)
 {
+    if (g_graphics.isHeadless())
+        return;
+
     const auto& filePath = g_resources.resolvePath(file.data());
     g_mainDispatcher.addEvent([this, name = name.data(), filePath, useFramebuffer] {
         const auto& shader = std::make_shared<PainterShaderProgram>();
@@ -82,6 +90,9 @@ void ShaderManager::createFragmentShader(const std::string_view name, const std:
 
 void ShaderManager::createFragmentShaderFromCode(const std::string_view name, const std::string_view code, bool useFramebuffer)
 {
+    if (g_graphics.isHeadless())
+        return;
+
     g_mainDispatcher.addEvent([this, name = name.data(), code = code.data(), useFramebuffer] {
         const auto& shader = std::make_shared<PainterShaderProgram>();
         shader->setUseFramebuffer(useFramebuffer);
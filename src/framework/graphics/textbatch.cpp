@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "textbatch.h"
+
+#include "bitmapfont.h"
+#include "cachedtext.h"
+#include "coordsbuffer.h"
+#include "drawpoolmanager.h"
+
+void TextBatch::add(CachedText& text, const Rect& dest, const Color& color)
+{
+    const auto* coords = text.getCoords(dest);
+    if (!coords || coords->getVertexCount() == 0)
+        return;
+
+    const auto& texture = text.getFont()->getTexture();
+    auto it = std::find_if(m_groups.begin(), m_groups.end(), [&texture, &color](const Group& group) {
+        return group.texture == texture && group.color == color;
+    });
+
+    if (it == m_groups.end())
+        it = m_groups.insert(m_groups.end(), Group{ .texture = texture, .color = color, .coords = std::make_shared<CoordsBuffer>() });
+
+    it->coords->append(coords);
+    m_empty = false;
+}
+
+void TextBatch::draw()
+{
+    if (m_empty)
+        return;
+
+    // groups left empty this pass are gone from the screen
+    std::erase_if(m_groups, [](const Group& group) { return group.coords->getVertexCount() == 0; });
+
+    for (const auto& group : m_groups) {
+        g_drawPool.addTexturedCoordsBuffer(group.texture, group.coords, group.color);
+        group.coords->clear();
+    }
+
+    m_empty = true;
+}
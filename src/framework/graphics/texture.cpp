@@ -65,7 +65,8 @@ Texture::~Texture()
     if (g_graphics.ok() && m_id != 0) {
         g_mainDispatcher.addEvent([id = m_id, smooth = isSmooth()]() mutable {
             g_drawPool.removeTextureFromAtlas(id, smooth);
-            glDeleteTextures(1, &id);
+            if (!g_graphics.isHeadless())
+                glDeleteTextures(1, &id);
         });
     }
 }
@@ -102,11 +103,11 @@ void Texture::uploadPixels(const ImagePtr& image, const bool buildMipmaps, const
     setupFilters();
 }
 
-void Texture::bind() { if (m_id) glBindTexture(GL_TEXTURE_2D, m_id); }
+void Texture::bind() { if (m_id && !g_graphics.isHeadless()) glBindTexture(GL_TEXTURE_2D, m_id); }
 
 void Texture::buildHardwareMipmaps()
 {
-    if (getProp(hasMipMaps))
+    if (getProp(hasMipMaps) || g_graphics.isHeadless())
         return;
 
 #ifndef OPENGL_ES
@@ -168,6 +169,13 @@ void Texture::setUpsideDown(const bool upsideDown)
 
 void Texture::createTexture()
 {
+    if (g_graphics.isHeadless()) {
+        if (m_id == 0)
+            m_id = g_graphics.genNullObjectId();
+        generateHash();
+        return;
+    }
+
     if (g_graphics.ok() && m_id != 0)
         glDeleteTextures(1, &m_id);
 
@@ -202,6 +210,9 @@ bool Texture::setupSize(const Size& size)
 
 void Texture::setupWrap() const
 {
+    if (g_graphics.isHeadless())
+        return;
+
     const GLint texParam = getProp(repeat) ? GL_REPEAT : GL_CLAMP_TO_EDGE;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texParam);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texParam);
@@ -209,7 +220,7 @@ void Texture::setupWrap() const
 
 void Texture::setupFilters() const
 {
-    if (!m_id) return;
+    if (!m_id || g_graphics.isHeadless()) return;
 
     GLenum minFilter;
     GLenum magFilter;
@@ -245,6 +256,10 @@ void Texture::setupPixels(const int level, const Size& size, const uint8_t* pixe
 #endif
 ) const
 {
+    g_graphics.addTextureUpload(static_cast<uint64_t>(size.area()) * channels);
+    if (g_graphics.isHeadless())
+        return;
+
     GLenum format = 0;
     GLenum internalFormat = GL_R8;
     switch (channels) {
@@ -13,28 +13,57 @@ static constexpr float MAX_ATLAS_TEXTURE_COVERAGE = 0.35f;
 // With SMOOTH_PADDING = 2 this results in 8 (4 + 2*2)
 static constexpr int MIN_PADDED_ATLAS_TEXTURE_SIZE = 4 + SMOOTH_PADDING * 2;
 
+// Compaction waits for the atlas to be idle (no new textures) and is planned at most once per interval (ms)
+static constexpr int COMPACTION_IDLE_DELAY = 5000;
+static constexpr int COMPACTION_INTERVAL = 30000;
+
+// Live regions must fit in one layer less at this occupancy for a compaction to be worth it
+static constexpr float COMPACTION_MAX_OCCUPANCY = 0.75f;
+
 TextureAtlas::TextureAtlas(Fw::TextureAtlasType type, int size, bool smoothSupport) :
     m_type(type),
     m_size({ std::min<int>(size, 8192) }) {
+    for (auto& group : m_filterGroups)
+        group.packer = AtlasPacker(m_size.width(), m_size.height());
+
     createNewLayer(false);
     if (smoothSupport)
         createNewLayer(true);
 }
 
 void TextureAtlas::removeTexture(uint32_t id, bool smooth) {
+    std::scoped_lock l(m_mutex);
+
     auto it = m_texturesCached.find(id);
     if (it == m_texturesCached.end()) {
         return;
     }
 
-    it->second->enabled = false;
+    auto& region = it->second;
+    region->enabled = false;
+
+    // the filter of a texture may have changed since it was added, the layer tells its group
+    if (!isGroupRegion(smooth, *region))
+        smooth = !smooth;
+
+    if (isGroupRegion(smooth, *region)) {
+        auto& group = m_filterGroups[smooth];
+        std::erase(group.layers[region->layer].textures, region.get());
+        ++group.changes;
+
+        const int padding = smooth ? SMOOTH_PADDING : 0;
+        group.packer.release({ region->x - padding, region->y - padding, region->width + padding * 2, region->height + padding * 2, region->layer });
+    }
 
-    auto sizeKey = std::make_pair(it->second->width, it->second->height);
-    m_filterGroups[smooth].inactiveTextures.try_emplace(sizeKey, std::vector<std::unique_ptr<AtlasRegion>>())
-        .first->second.emplace_back(std::move(it->second));
     m_texturesCached.erase(it);
 }
 
+bool TextureAtlas::isGroupRegion(const bool smooth, const AtlasRegion& region) const {
+    const auto& layers = m_filterGroups[smooth].layers;
+    return region.layer >= 0 && region.layer < static_cast<int>(layers.size())
+        && layers[region.layer].framebuffer->getTexture().get() == region.atlas;
+}
+
 bool TextureAtlas::canAdd(const TexturePtr& texture) const {
     const auto textureWidth = texture->getWidth();
     const auto textureHeight = texture->getHeight();
@@ -67,71 +96,170 @@ void TextureAtlas::addTexture(const TexturePtr& texture) {
     const auto textureId = texture->getId();
     const auto textureWidth = texture->getWidth();
     const auto textureHeight = texture->getHeight();
+    const bool smooth = texture->isSmooth();
 
-    auto& filterGroup = m_filterGroups[texture->isSmooth()];
-
-    const auto sizeKey = std::make_pair(textureWidth, textureHeight);
-    if (auto it = filterGroup.inactiveTextures.find(sizeKey);
-        it != filterGroup.inactiveTextures.end()) {
-        auto& pool = it->second;
-        if (!pool.empty()) {
-            auto regionInfo = std::move(pool.back());
-            pool.pop_back();
-
-            regionInfo->textureID = textureId;
-            regionInfo->transformMatrixId = texture->getTransformMatrixId();
-            texture->m_atlas[m_type] = regionInfo.get();
-
-            filterGroup.layers[regionInfo->layer].textures.emplace_back(regionInfo.get());
-            m_texturesCached.emplace(textureId, std::move(regionInfo));
-            return;
-        }
-    }
+    std::scoped_lock l(m_mutex);
+    auto& filterGroup = m_filterGroups[smooth];
 
-    const int padding = texture->isSmooth() ? SMOOTH_PADDING : 0;
+    const int padding = smooth ? SMOOTH_PADDING : 0;
     const int paddedWidth = textureWidth + padding * 2;
     const int paddedHeight = textureHeight + padding * 2;
 
-    auto bestRegion = findBestRegion(paddedWidth, paddedHeight, texture->isSmooth());
-    if (!bestRegion) {
-        createNewLayer(texture->isSmooth());
-        return addTexture(texture);
+    auto region = filterGroup.packer.allocate(paddedWidth, paddedHeight);
+    if (!region) {
+        createNewLayer(smooth);
+        region = filterGroup.packer.allocate(paddedWidth, paddedHeight);
+        if (!region)
+            return;
     }
 
-    FreeRegion region = *bestRegion;
-    splitRegion(region, paddedWidth, paddedHeight, texture->isSmooth());
+    m_lastAddition.restart();
+    ++filterGroup.changes;
 
     auto regionInfo = std::make_unique<AtlasRegion>(
         textureId,
-        region.x + padding,
-        region.y + padding,
-        region.layer,
+        region->x + padding,
+        region->y + padding,
+        region->layer,
         static_cast<int16_t>(textureWidth),
         static_cast<int16_t>(textureHeight),
         texture->getTransformMatrixId(),
-        m_filterGroups[texture->isSmooth()].layers[region.layer].framebuffer->getTexture().get()
+        filterGroup.layers[region->layer].framebuffer->getTexture().get()
     );
 
     texture->m_atlas[m_type] = regionInfo.get();
-    filterGroup.layers[region.layer].textures.emplace_back(regionInfo.get());
+    filterGroup.layers[region->layer].textures.emplace_back(regionInfo.get());
     m_texturesCached.emplace(textureId, std::move(regionInfo));
 }
 
-void TextureAtlas::createNewLayer(bool smooth) {
+std::unique_ptr<FrameBuffer> TextureAtlas::createLayerFramebuffer(const bool smooth) const {
     auto fbo = std::make_unique<FrameBuffer>();
     fbo->setAutoClear(false);
     fbo->setAutoResetState(true);
     fbo->setSmooth(smooth);
     fbo->resize(m_size);
+    return fbo;
+}
 
-    FreeRegion newRegion = { 0, 0, m_size.width(), m_size.height(), static_cast<int>(m_filterGroups[smooth].layers.size()) };
+void TextureAtlas::createNewLayer(bool smooth) {
+    m_filterGroups[smooth].layers.emplace_back(createLayerFramebuffer(smooth));
+    m_filterGroups[smooth].packer.addLayer();
+}
 
-    m_filterGroups[smooth].layers.emplace_back(std::move(fbo));
-    m_filterGroups[smooth].freeRegions.insert(newRegion);
-    m_filterGroups[smooth].freeRegionsBySize[m_size.width() * m_size.height()].insert(newRegion);
+AtlasPacker::Stats TextureAtlas::getStats(const bool smooth) const {
+    std::scoped_lock l(m_mutex);
+    return m_filterGroups[smooth].packer.getStats();
+}
+
+void TextureAtlas::planCompactionIfIdle() {
+    std::scoped_lock l(m_mutex);
+
+    if (m_lastAddition.ticksElapsed() < COMPACTION_IDLE_DELAY || m_lastCompaction.ticksElapsed() < COMPACTION_INTERVAL)
+        return;
+
+    m_lastCompaction.restart();
+
+    for (auto i = -1; ++i < AtlasFilter::ATLAS_FILTER_COUNT;) {
+        const auto& group = m_filterGroups[i];
+        if (group.pending)
+            continue;
+
+        const auto& stats = group.packer.getStats();
+        const auto spareLayersArea = (stats.layers - 1) * group.packer.getLayerArea();
+        if (stats.layers > 1 && stats.usedArea <= spareLayersArea * COMPACTION_MAX_OCCUPANCY)
+            planCompaction(i == AtlasFilter::ATLAS_FILTER_LINEAR);
+    }
+}
+
+void TextureAtlas::planCompaction(const bool smooth) {
+    auto& group = m_filterGroups[smooth];
+    const int padding = smooth ? SMOOTH_PADDING : 0;
+
+    auto pending = std::make_unique<PendingCompaction>();
+    pending->changes = group.changes;
+
+    std::vector<std::pair<int, int>> sizes;
+    for (const auto& [id, region] : m_texturesCached) {
+        if (!isGroupRegion(smooth, *region))
+            continue;
+
+        pending->regions.emplace_back(region.get());
+        sizes.emplace_back(region->width + padding * 2, region->height + padding * 2);
+    }
+
+    pending->packer = AtlasPacker(m_size.width(), m_size.height());
+    auto placements = pending->packer.pack(sizes);
+    if (!placements || pending->packer.getLayerCount() >= group.packer.getLayerCount())
+        return;
+
+    if (pending->packer.getLayerCount() == 0)
+        pending->packer.addLayer();
+
+    // fresh layers, the current ones keep serving the arenas already recorded against them
+    for (int i = 0; i < pending->packer.getLayerCount(); ++i)
+        pending->layers.emplace_back(createLayerFramebuffer(smooth));
+
+    pending->placements = std::move(*placements);
+    group.pending = std::move(pending);
+}
+
+bool TextureAtlas::applyCompaction() {
+    std::scoped_lock l(m_mutex);
+
+    const uint32_t epoch = getEpoch() + 1;
+    bool applied = false;
+
+    for (auto i = -1; ++i < AtlasFilter::ATLAS_FILTER_COUNT;) {
+        auto& group = m_filterGroups[i];
+        if (!group.pending)
+            continue;
+
+        const auto pending = std::move(group.pending);
+
+        // textures came or went since the plan, its layers were never referenced
+        if (pending->changes != group.changes) {
+            m_retiredLayers.emplace_back(0, std::move(pending->layers));
+            continue;
+        }
+
+        const int padding = i == AtlasFilter::ATLAS_FILTER_LINEAR ? SMOOTH_PADDING : 0;
+
+        // regions move in place, so the textures keep their pointers; the next flush draws them into
+        // the new layers and the new generation invalidates vertex buffers built for them
+        for (size_t j = 0; j < pending->regions.size(); ++j) {
+            auto* region = pending->regions[j];
+            const auto& placement = pending->placements[j];
+            auto& layer = pending->layers[placement.layer];
+
+            region->enabled.store(false, std::memory_order_release);
+            region->x = static_cast<int16_t>(placement.x + padding);
+            region->y = static_cast<int16_t>(placement.y + padding);
+            region->layer = static_cast<int8_t>(placement.layer);
+            region->atlas = layer.framebuffer->getTexture().get();
+            region->generation = AtlasRegion::nextGeneration();
+            layer.textures.emplace_back(region);
+        }
+
+        m_retiredLayers.emplace_back(epoch, std::move(group.layers));
+        group.layers = std::move(pending->layers);
+        group.packer = std::move(pending->packer);
+        applied = true;
+    }
+
+    if (applied)
+        m_epoch.store(epoch, std::memory_order_release);
+
+    return applied;
+}
+
+void TextureAtlas::releaseRetiredLayers(const uint32_t drawnEpoch) {
+    std::scoped_lock l(m_mutex);
+    std::erase_if(m_retiredLayers, [drawnEpoch](const auto& retired) { return retired.first <= drawnEpoch; });
 }
 
 void TextureAtlas::flush() {
+    std::scoped_lock l(m_mutex);
+
     static CoordsBuffer buffer;
     for (auto i = -1; ++i < AtlasFilter::ATLAS_FILTER_COUNT;) {
         auto& group = m_filterGroups[i];
@@ -141,7 +269,7 @@ void TextureAtlas::flush() {
         for (auto& layer : group.layers) {
             if (!layer.textures.empty()) {
                 layer.framebuffer->bind();
-                glDisable(GL_BLEND);
+                g_painter->setBlending(false);
                 for (const auto& texture : layer.textures) {
                     const int x = texture->x;
                     const int y = texture->y;
@@ -166,7 +294,7 @@ void TextureAtlas::flush() {
 
                     texture->enabled.store(true, std::memory_order_release);
                 }
-                glEnable(GL_BLEND);
+                g_painter->setBlending(true);
                 layer.textures.clear();
                 layer.framebuffer->release();
             }
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "atlaspacker.h"
 #include "declarations.h"
 
+#include <framework/core/timer.h>
+
+#include <mutex>
+
 class AtlasRegion
 {
 public:
@@ -12,6 +17,7 @@ public:
     int16_t width;
     int16_t height;
     uint16_t transformMatrixId;
+    uint32_t generation;
     Texture* atlas;
     std::atomic_bool enabled;
 
@@ -22,34 +28,39 @@ public:
     AtlasRegion(uint32_t tid, int16_t x, int16_t y, int8_t layer,
                 int16_t width, int16_t height, uint16_t transformId, Texture* atlas)
         : textureID(tid), x(x), y(y), layer(layer),
-        width(width), height(height), transformMatrixId(transformId), atlas(atlas) {
-    }
-};
-
-struct FreeRegion
-{
-    int x, y, width, height, layer;
-
-    bool operator<(const FreeRegion& other) const {
-        if (layer != other.layer) return layer < other.layer;
-        if (width * height != other.width * other.height)
-            return (width * height) < (other.width * other.height);
-        return (y != other.y) ? (y < other.y) : (x < other.x);
+        width(width), height(height), transformMatrixId(transformId), generation(nextGeneration()), atlas(atlas) {
     }
 
-    bool canFit(int texWidth, int texHeight) const {
-        return width >= texWidth && height >= texHeight;
+    // atlases place regions from the render thread and apply compactions from the map thread
+    static uint32_t nextGeneration() {
+        static std::atomic<uint32_t> generation{ 0 };
+        return generation.fetch_add(1, std::memory_order_relaxed) + 1;
     }
 };
 
-struct PairHash
+// Atlas placement a cached vertex buffer was built for. Every placement gets a new
+// generation, compaction moves regions in place and reused memory may share an address.
+class AtlasRegionRef
 {
-    template <typename T1, typename T2>
-    std::size_t operator()(const std::pair<T1, T2>& pair) const {
-        auto hash = stdext::hash_int(pair.first);
-        stdext::hash_combine(hash, stdext::hash_int(pair.second));
-        return hash;
+public:
+    // returns true when the placement changed since the last call
+    bool update(const AtlasRegion* region) {
+        const uint32_t generation = region ? region->generation : 0;
+        if (region == m_region && generation == m_generation)
+            return false;
+
+        m_region = region;
+        m_generation = generation;
+        return true;
     }
+
+    const AtlasRegion* get() const { return m_region; }
+    const AtlasRegion* operator->() const { return m_region; }
+    explicit operator bool() const { return m_region != nullptr; }
+
+private:
+    const AtlasRegion* m_region = nullptr;
+    uint32_t m_generation = 0;
 };
 
 enum AtlasFilter
@@ -72,6 +83,19 @@ public:
 
     void flush();
 
+    // Compaction repacks the live regions into fewer layers once the atlas was left alone for a while.
+    // The render thread plans it into fresh layers, the map thread applies it between frames while no
+    // recording is in flight, and the old layers stay alive until every pool sharing the atlas draws
+    // an arena recorded after the move.
+    void planCompactionIfIdle();
+    bool applyCompaction();
+    void releaseRetiredLayers(uint32_t drawnEpoch);
+
+    // bumped by every applied compaction, arenas remember the placements they were recorded against
+    uint32_t getEpoch() const { return m_epoch.load(std::memory_order_acquire); }
+
+    AtlasPacker::Stats getStats(bool smooth) const;
+
     auto getType() const { return m_type; }
 
 private:
@@ -80,48 +104,42 @@ private:
         std::unique_ptr<FrameBuffer> framebuffer;
         std::vector<AtlasRegion*> textures;
     };
-    void createNewLayer(bool smooth);
 
-    std::optional<FreeRegion> findBestRegion(int width, int height, bool smooth) {
-        auto sizeIt = m_filterGroups[smooth].freeRegionsBySize.lower_bound(width * height);
-        while (sizeIt != m_filterGroups[smooth].freeRegionsBySize.end()) {
-            for (const auto& region : sizeIt->second) {
-                if (region.canFit(width, height)) {
-                    return region;
-                }
-            }
-            ++sizeIt;
-        }
-        return std::nullopt;
-    }
+    struct PendingCompaction
+    {
+        uint32_t changes{ 0 };
+        std::vector<Layer> layers;
+        std::vector<AtlasRegion*> regions;
+        std::vector<FreeRegion> placements;
+        AtlasPacker packer{ 0, 0 };
+    };
 
-    void splitRegion(const FreeRegion& region, int width, int height, bool smooth) {
-        m_filterGroups[smooth].freeRegions.erase(region);
-        m_filterGroups[smooth].freeRegionsBySize[region.width * region.height].erase(region);
-
-        auto insertRegion = [&](int x, int y, int w, int h) {
-            if (w > 0 && h > 0) {
-                FreeRegion r = { x, y, w, h, region.layer };
-                m_filterGroups[smooth].freeRegions.insert(r);
-                m_filterGroups[smooth].freeRegionsBySize[w * h].insert(r);
-            }
-        };
-
-        insertRegion(region.x + width, region.y, region.width - width, height);
-        insertRegion(region.x, region.y + height, width, region.height - height);
-        insertRegion(region.x + width, region.y + height, region.width - width, region.height - height);
-    }
+    std::unique_ptr<FrameBuffer> createLayerFramebuffer(bool smooth) const;
+    void createNewLayer(bool smooth);
+    bool isGroupRegion(bool smooth, const AtlasRegion& region) const;
+    void planCompaction(bool smooth);
 
     Fw::TextureAtlasType m_type;
     Size m_size;
 
-    struct
+    struct FilterGroup
     {
         std::vector<Layer> layers;
-        std::set<FreeRegion> freeRegions;
-        std::map<int, std::set<FreeRegion>> freeRegionsBySize;
-        phmap::flat_hash_map<std::pair<int, int>, std::vector<std::unique_ptr<AtlasRegion>>, PairHash> inactiveTextures;
+        AtlasPacker packer{ 0, 0 };
+
+        // additions and removals since the start, a plan made before any of them is stale
+        uint32_t changes{ 0 };
+        std::unique_ptr<PendingCompaction> pending;
     } m_filterGroups[AtlasFilter::ATLAS_FILTER_COUNT];
 
     phmap::flat_hash_map<uint32_t, std::unique_ptr<AtlasRegion>> m_texturesCached;
+
+    // layers replaced by a compaction, with the epoch from which no new recording references them
+    std::vector<std::pair<uint32_t, std::vector<Layer>>> m_retiredLayers;
+    std::atomic<uint32_t> m_epoch{ 0 };
+
+    mutable std::mutex m_mutex;
+
+    Timer m_lastAddition;
+    Timer m_lastCompaction;
 };
\ No newline at end of file
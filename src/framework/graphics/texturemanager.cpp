@@ -63,10 +63,17 @@ void TextureManager::poll()
     lastUpdate = now;
 
     std::shared_lock l(m_mutex);
-    for (const auto& animatedTexture : m_animatedTextures)
+    for (const auto& animatedTexture : m_animatedTextures) {
+        // streaming animations decode their next frames on the async dispatcher
+        animatedTexture->prefetch();
         animatedTexture->update();
+    }
 }
 
+void TextureManager::setAnimationStreamingMemoryLimit(const size_t bytes) { AnimatedTexture::setStreamingMemoryLimit(bytes); }
+size_t TextureManager::getAnimationStreamingMemoryLimit() const { return AnimatedTexture::getStreamingMemoryLimit(); }
+size_t TextureManager::getAnimationStreamingMemoryUsage() const { return AnimatedTexture::getStreamingMemoryUsage(); }
+
 void TextureManager::clearCache()
 {
     std::unique_lock l(m_mutex);
@@ -161,11 +168,35 @@ TexturePtr TextureManager::loadTexture(std::stringstream& file)
     apng_data apng;
     if (load_apng(file, &apng) == 0) {
         const Size imageSize(apng.width, apng.height);
-        if (apng.num_frames > 1) { // animated texture
+        const size_t frameBytes = static_cast<size_t>(imageSize.area()) * apng.bpp;
+        std::vector<std::vector<uint8_t>> compressedFrames;
+        if (apng.num_frames > 1 && m_animationStreamingThreshold > 0 && frameBytes * apng.num_frames > m_animationStreamingThreshold) {
+            for (uint32_t i = 0; i < apng.num_frames; ++i) {
+                const uint8_t* frameData = apng.pdata + ((apng.first_frame + i) * frameBytes);
+
+                auto& frame = compressedFrames.emplace_back(compressBound(frameBytes));
+                uLongf length = frame.size();
+                if (const int result = compress2(frame.data(), &length, frameData, frameBytes, Z_BEST_SPEED); result != Z_OK) {
+                    g_logger.warning("Unable to compress frame {} of a streamed animation (zlib error {}), keeping it decoded in memory", i, result);
+                    compressedFrames.clear();
+                    break;
+                }
+
+                frame.resize(length);
+                frame.shrink_to_fit();
+            }
+        }
+
+        if (!compressedFrames.empty()) {
+            const std::vector<uint16_t> framesDelay(apng.frames_delay, apng.frames_delay + apng.num_frames);
+            const auto& animatedTexture = std::make_shared<AnimatedTexture>(imageSize, apng.bpp, std::move(compressedFrames), framesDelay, apng.num_plays, m_animationStreamingRingSize);
+            std::scoped_lock l(m_mutex);
+            texture = m_animatedTextures.emplace_back(animatedTexture);
+        } else if (apng.num_frames > 1) { // animated texture
             std::vector<ImagePtr> frames;
             std::vector<uint16_t> framesDelay;
             for (uint32_t i = 0; i < apng.num_frames; ++i) {
-                uint8_t* frameData = apng.pdata + ((apng.first_frame + i) * imageSize.area() * apng.bpp);
+                uint8_t* frameData = apng.pdata + ((apng.first_frame + i) * frameBytes);
 
                 framesDelay.push_back(apng.frames_delay[i]);
                 frames.emplace_back(std::make_shared<Image>(imageSize, apng.bpp, frameData));
@@ -41,6 +41,16 @@ public:
     const TexturePtr& getEmptyTexture() { return m_emptyTexture; }
     TexturePtr loadTexture(std::stringstream& file);
 
+    // animations whose decoded frames exceed the threshold are streamed: frames stay compressed and
+    // only a ring of ringSize textures around the current frame is decoded, 0 disables streaming
+    void setAnimationStreamingThreshold(const size_t bytes) { m_animationStreamingThreshold = bytes; }
+    size_t getAnimationStreamingThreshold() const { return m_animationStreamingThreshold; }
+    void setAnimationStreamingRingSize(const uint8_t frames) { m_animationStreamingRingSize = std::max<uint8_t>(frames, 2); }
+    uint8_t getAnimationStreamingRingSize() const { return m_animationStreamingRingSize; }
+    void setAnimationStreamingMemoryLimit(size_t bytes);
+    size_t getAnimationStreamingMemoryLimit() const;
+    size_t getAnimationStreamingMemoryUsage() const;
+
     const Matrix3* getMatrixById(uint16_t id);
     uint16_t getMatrixId(const Size& size, bool upsidedown);
 
@@ -51,6 +61,9 @@ private:
     ScheduledEventPtr m_liveReloadEvent;
     std::shared_mutex m_mutex;
 
+    size_t m_animationStreamingThreshold{ 16 * 1024 * 1024 };
+    uint8_t m_animationStreamingRingSize{ 4 };
+
     struct
     {
         std::unordered_map<uint64_t, uint16_t> indexMap;
@@ -215,6 +215,9 @@ bool luavalue_cast(int index, std::list<T>& list);
 template<typename T>
 int push_luavalue(const std::vector<T>& vec);
 
+template<typename T, uint32_t N>
+int push_luavalue(const stdext::small_vector<T, N>& vec);
+
 template<typename T>
 bool luavalue_cast(int index, std::vector<T>& vec);
 
@@ -423,6 +426,19 @@ int push_luavalue(const std::vector<T>& vec)
     return 1;
 }
 
+template<typename T, uint32_t N>
+int push_luavalue(const stdext::small_vector<T, N>& vec)
+{
+    g_lua.createTable(vec.size(), 0);
+    int i = 1;
+    for (const T& v : vec) {
+        push_internal_luavalue(v);
+        g_lua.rawSeti(i);
+        ++i;
+    }
+    return 1;
+}
+
 template<typename T>
 bool luavalue_cast(const int index, std::vector<T>& vec)
 {
@@ -34,6 +34,7 @@
 #include <framework/util/crypt.h>
 
 #ifdef FRAMEWORK_GRAPHICS
+#include "framework/graphics/drawpoolmanager.h"
 #include "framework/graphics/fontmanager.h"
 #include "framework/graphics/graphics.h"
 #include "framework/graphics/particleeffect.h"
@@ -345,6 +346,10 @@ void Application::registerLuaFunctions()
     g_lua.bindSingletonFunction("g_app", "getTargetFps", &GraphicalApplication::getTargetFps, &g_app);
     g_lua.bindSingletonFunction("g_app", "setTargetFps", &GraphicalApplication::setTargetFps, &g_app);
     g_lua.bindSingletonFunction("g_app", "resetTargetFps", &GraphicalApplication::resetTargetFps, &g_app);
+    g_lua.bindSingletonFunction("g_app", "getFrameTimeStats", &GraphicalApplication::getFrameTimeStats, &g_app);
+    g_lua.bindSingletonFunction("g_app", "getWorstFrames", &GraphicalApplication::getWorstFrames, &g_app);
+    g_lua.bindSingletonFunction("g_app", "getSlowFrameThreshold", &GraphicalApplication::getSlowFrameThreshold, &g_app);
+    g_lua.bindSingletonFunction("g_app", "setSlowFrameThreshold", &GraphicalApplication::setSlowFrameThreshold, &g_app);
 
     g_lua.bindSingletonFunction("g_app", "isDrawingTexts", &GraphicalApplication::isDrawingTexts, &g_app);
     g_lua.bindSingletonFunction("g_app", "setDrawTexts", &GraphicalApplication::setDrawTexts, &g_app);
@@ -416,12 +421,30 @@ void Application::registerLuaFunctions()
     g_lua.bindSingletonFunction("g_graphics", "getVendor", &Graphics::getVendor, &g_graphics);
     g_lua.bindSingletonFunction("g_graphics", "getRenderer", &Graphics::getRenderer, &g_graphics);
     g_lua.bindSingletonFunction("g_graphics", "getVersion", &Graphics::getVersion, &g_graphics);
+    g_lua.bindSingletonFunction("g_graphics", "isHeadless", &Graphics::isHeadless, &g_graphics);
+    g_lua.bindSingletonFunction("g_graphics", "getRenderStats", &Graphics::getRenderStats, &g_graphics);
+    g_lua.bindSingletonFunction("g_graphics", "resetRenderStats", &Graphics::resetRenderStats, &g_graphics);
+
+    // DrawPool
+    g_lua.registerSingletonClass("g_drawPool");
+    g_lua.bindSingletonFunction("g_drawPool", "setBatchSorting", &DrawPoolManager::setBatchSorting, &g_drawPool);
+    g_lua.bindSingletonFunction("g_drawPool", "isBatchSorting", &DrawPoolManager::isBatchSorting, &g_drawPool);
+    g_lua.bindSingletonFunction("g_drawPool", "getBatchCountBeforeSort", &DrawPoolManager::getBatchCountBeforeSort, &g_drawPool);
+    g_lua.bindSingletonFunction("g_drawPool", "getBatchCountAfterSort", &DrawPoolManager::getBatchCountAfterSort, &g_drawPool);
+    g_lua.bindSingletonFunction("g_drawPool", "getAtlasReport", &DrawPoolManager::getAtlasReport, &g_drawPool);
 
     // Textures
     g_lua.registerSingletonClass("g_textures");
     g_lua.bindSingletonFunction("g_textures", "preload", &TextureManager::preload, &g_textures);
     g_lua.bindSingletonFunction("g_textures", "clearCache", &TextureManager::clearCache, &g_textures);
     g_lua.bindSingletonFunction("g_textures", "liveReload", &TextureManager::liveReload, &g_textures);
+    g_lua.bindSingletonFunction("g_textures", "setAnimationStreamingThreshold", &TextureManager::setAnimationStreamingThreshold, &g_textures);
+    g_lua.bindSingletonFunction("g_textures", "getAnimationStreamingThreshold", &TextureManager::getAnimationStreamingThreshold, &g_textures);
+    g_lua.bindSingletonFunction("g_textures", "setAnimationStreamingRingSize", &TextureManager::setAnimationStreamingRingSize, &g_textures);
+    g_lua.bindSingletonFunction("g_textures", "getAnimationStreamingRingSize", &TextureManager::getAnimationStreamingRingSize, &g_textures);
+    g_lua.bindSingletonFunction("g_textures", "setAnimationStreamingMemoryLimit", &TextureManager::setAnimationStreamingMemoryLimit, &g_textures);
+    g_lua.bindSingletonFunction("g_textures", "getAnimationStreamingMemoryLimit", &TextureManager::getAnimationStreamingMemoryLimit, &g_textures);
+    g_lua.bindSingletonFunction("g_textures", "getAnimationStreamingMemoryUsage", &TextureManager::getAnimationStreamingMemoryUsage, &g_textures);
 
     // UI
     g_lua.registerSingletonClass("g_ui");
@@ -455,6 +478,12 @@ void Application::registerLuaFunctions()
     g_lua.bindSingletonFunction("g_fonts", "clearFonts", &FontManager::clearFonts, &g_fonts);
     g_lua.bindSingletonFunction("g_fonts", "importFont", &FontManager::importFont, &g_fonts);
     g_lua.bindSingletonFunction("g_fonts", "fontExists", &FontManager::fontExists, &g_fonts);
+    g_lua.bindSingletonFunction("g_fonts", "setLayoutCacheLimit", &FontManager::setLayoutCacheLimit, &g_fonts);
+    g_lua.bindSingletonFunction("g_fonts", "getLayoutCacheLimit", &FontManager::getLayoutCacheLimit, &g_fonts);
+    g_lua.bindSingletonFunction("g_fonts", "getLayoutCacheSize", &FontManager::getLayoutCacheSize, &g_fonts);
+    g_lua.bindSingletonFunction("g_fonts", "clearLayoutCache", &FontManager::clearLayoutCache, &g_fonts);
+    g_lua.bindSingletonFunction("g_fonts", "getLayoutCacheStats", &FontManager::getLayoutCacheStats, &g_fonts);
+    g_lua.bindSingletonFunction("g_fonts", "resetLayoutCacheStats", &FontManager::resetLayoutCacheStats, &g_fonts);
 
     // ParticleManager
     g_lua.registerSingletonClass("g_particles");
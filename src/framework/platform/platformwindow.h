@@ -136,6 +136,12 @@ public:
 
     void setKeyDelay(const Fw::Key key, const uint8_t delay) { if (key < Fw::KeyLast) m_keyInfo[key].delay = delay; }
 
+    // a headless window never opens a display, a native window or a GL context,
+    // it only keeps its logical state (size, position, visibility); must be set before init()
+    // @dontbind
+    void setHeadless(const bool headless) { m_headless = headless; }
+    bool isHeadless() const { return m_headless; }
+
 protected:
 
     virtual int internalLoadMouseCursor(const ImagePtr& image, const Point& hotSpot) = 0;
@@ -168,6 +174,7 @@ protected:
     bool m_fullscreen{ false };
     bool m_maximized{ false };
     bool m_vsync{ false };
+    bool m_headless{ false };
     float m_displayDensity{ DEFAULT_DISPLAY_DENSITY };
 
     std::function<void()> m_onClose;
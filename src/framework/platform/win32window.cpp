@@ -220,6 +220,9 @@ WIN32Window::WIN32Window()
 
 void WIN32Window::init()
 {
+    if (m_headless)
+        return;
+
     timeBeginPeriod(1);
 
     m_instance = GetModuleHandle(nullptr);
@@ -231,6 +234,11 @@ void WIN32Window::init()
 
 void WIN32Window::terminate()
 {
+    if (m_headless) {
+        m_visible = false;
+        return;
+    }
+
     SetCursor(nullptr);
     if (m_defaultCursor) {
         DestroyCursor(m_defaultCursor);
@@ -464,6 +472,10 @@ void* WIN32Window::getExtensionProcAddress(const char* ext)
 void WIN32Window::move(const Point& pos)
 {
     g_mainDispatcher.addEvent([&, pos] {
+        if (m_headless) {
+            m_position = pos;
+            return;
+        }
         const Rect clientRect(pos, getClientRect().size());
         const auto& windowRect = adjustWindowRect(clientRect);
         MoveWindow(m_window, windowRect.x(), windowRect.y(), windowRect.width(), windowRect.height(), TRUE);
@@ -477,6 +489,13 @@ void WIN32Window::resize(const Size& size)
     g_mainDispatcher.addEvent([&, size] {
         if (size.width() < m_minimumSize.width() || size.height() < m_minimumSize.height())
             return;
+        if (m_headless) {
+            // no WM_SIZE will come, apply the size right away
+            m_size = size;
+            if (m_onResize)
+                m_onResize(m_size);
+            return;
+        }
         const Rect clientRect(getClientRect().topLeft(), size);
         const auto& windowRect = adjustWindowRect(clientRect);
         MoveWindow(m_window, windowRect.x(), windowRect.y(), windowRect.width(), windowRect.height(), TRUE);
@@ -489,6 +508,10 @@ void WIN32Window::show()
 {
     g_mainDispatcher.addEvent([this] {
         m_hidden = false;
+        if (m_headless) {
+            m_visible = true;
+            return;
+        }
         if (m_maximized)
             ShowWindow(m_window, SW_MAXIMIZE);
         else
@@ -500,6 +523,10 @@ void WIN32Window::hide()
 {
     g_mainDispatcher.addEvent([this] {
         m_hidden = true;
+        if (m_headless) {
+            m_visible = false;
+            return;
+        }
         ShowWindow(m_window, SW_HIDE);
     });
 }
@@ -507,7 +534,7 @@ void WIN32Window::hide()
 void WIN32Window::maximize()
 {
     g_mainDispatcher.addEvent([this] {
-        if (!m_hidden)
+        if (!m_hidden && !m_headless)
             ShowWindow(m_window, SW_MAXIMIZE);
         else
             m_maximized = true;
@@ -516,6 +543,9 @@ void WIN32Window::maximize()
 
 void WIN32Window::poll()
 {
+    if (m_headless)
+        return;
+
     fireKeysPress();
     MSG msg;
     while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
@@ -838,6 +868,9 @@ LRESULT WIN32Window::windowProc(const HWND hWnd, const uint32_t uMsg, const WPAR
 
 void WIN32Window::swapBuffers()
 {
+    if (m_headless)
+        return;
+
 #ifdef OPENGL_ES
     eglSwapBuffers(m_eglDisplay, m_eglSurface);
 #else
@@ -847,11 +880,17 @@ void WIN32Window::swapBuffers()
 
 void WIN32Window::showMouse()
 {
+    if (m_headless)
+        return;
+
     ShowCursor(true);
 }
 
 void WIN32Window::hideMouse()
 {
+    if (m_headless)
+        return;
+
     ShowCursor(false);
 }
 
@@ -862,6 +901,9 @@ void WIN32Window::displayFatalError(const std::string_view message)
 
 int WIN32Window::internalLoadMouseCursor(const ImagePtr& image, const Point& hotSpot)
 {
+    if (m_headless)
+        return -1;
+
     const int width = image->getWidth();
     const int height = image->getHeight();
     const int numbits = width * height;
@@ -886,6 +928,9 @@ int WIN32Window::internalLoadMouseCursor(const ImagePtr& image, const Point& hot
 
 void WIN32Window::setMouseCursor(int cursorId)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, cursorId] {
         if (cursorId >= static_cast<int>(m_cursors.size()) || cursorId < 0)
             return;
@@ -898,6 +943,9 @@ void WIN32Window::setMouseCursor(int cursorId)
 
 void WIN32Window::restoreMouseCursor()
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([this] {
         if (m_cursor) {
             m_cursor = nullptr;
@@ -909,6 +957,9 @@ void WIN32Window::restoreMouseCursor()
 
 void WIN32Window::setTitle(const std::string_view title)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, title = std::string{ title }] {
         SetWindowTextW(m_window, stdext::latin1_to_utf16(title).data());
     });
@@ -929,6 +980,9 @@ void WIN32Window::setFullscreen(bool fullscreen)
         return;
 
     m_fullscreen = fullscreen;
+    if (m_headless)
+        return;
+
     wpPrev.length = sizeof(wpPrev);
 
     g_mainDispatcher.addEvent([this, fullscreen] {
@@ -950,6 +1004,8 @@ void WIN32Window::setFullscreen(bool fullscreen)
 void WIN32Window::setVerticalSync(bool enable)
 {
     m_vsync = enable;
+    if (m_headless)
+        return;
 
     g_mainDispatcher.addEvent([this, enable] {
 #ifdef OPENGL_ES
@@ -969,6 +1025,9 @@ void WIN32Window::setVerticalSync(bool enable)
 
 void WIN32Window::setIcon(const std::string& file)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, file] {
         const auto& image = Image::load(file);
 
@@ -1013,6 +1072,9 @@ void WIN32Window::setIcon(const std::string& file)
 
 void WIN32Window::setClipboardText(const std::string_view text)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, text = std::string{ text }] {
         if (!OpenClipboard(m_window))
             return;
@@ -1036,6 +1098,9 @@ void WIN32Window::setClipboardText(const std::string_view text)
 
 void WIN32Window::setTitleBarColor(const Color& color)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([this, color] {
         if (!m_window) {
             g_logger.warning("Window not created yet, cannot set title bar color");
@@ -1074,6 +1139,9 @@ void WIN32Window::setTitleBarColor(const Color& color)
 
 Size WIN32Window::getDisplaySize()
 {
+    if (m_headless)
+        return m_size;
+
     return { GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN) };
 }
 
@@ -1081,7 +1149,7 @@ std::string WIN32Window::getClipboardText()
 {
     std::string text;
 
-    if (!OpenClipboard(m_window))
+    if (m_headless || !OpenClipboard(m_window))
         return text;
 
     const HGLOBAL hglb = GetClipboardData(CF_UNICODETEXT);
@@ -216,6 +216,9 @@ X11Window::X11Window()
 
 void X11Window::init()
 {
+    if (m_headless)
+        return;
+
     internalOpenDisplay();
     internalCheckGL();
     internalChooseGLVisual();
@@ -531,7 +534,7 @@ void X11Window::move(const Point& pos)
 {
     g_mainDispatcher.addEvent([&, pos] {
         m_position = pos;
-        if (m_visible) {
+        if (m_visible && !m_headless) {
             XMoveWindow(m_display, m_window, m_position.x, m_position.y);
             XFlush(m_display);
         }
@@ -543,6 +546,13 @@ void X11Window::resize(const Size& size)
     g_mainDispatcher.addEvent([&, size] {
         if (size.width() < m_minimumSize.width() || size.height() < m_minimumSize.height())
             return;
+        if (m_headless) {
+            // no ConfigureNotify will come, apply the size right away
+            m_size = size;
+            if (m_onResize)
+                m_onResize(m_size);
+            return;
+        }
         XResizeWindow(m_display, m_window, size.width(), size.height());
         XFlush(m_display);
         });
@@ -552,6 +562,8 @@ void X11Window::show()
 {
     g_mainDispatcher.addEvent([&] {
         m_visible = true;
+        if (m_headless)
+            return;
         XMapWindow(m_display, m_window);
         XMoveWindow(m_display, m_window, m_position.x, m_position.y);
         XFlush(m_display);
@@ -566,6 +578,8 @@ void X11Window::hide()
 {
     g_mainDispatcher.addEvent([&] {
         m_visible = false;
+        if (m_headless)
+            return;
         XUnmapWindow(m_display, m_window);
         XFlush(m_display);
         });
@@ -574,7 +588,7 @@ void X11Window::hide()
 void X11Window::maximize()
 {
     g_mainDispatcher.addEvent([&] {
-        if (m_visible) {
+        if (m_visible && !m_headless) {
             Atom wmState = XInternAtom(m_display, "_NET_WM_STATE", False);
             Atom wmStateMaximizedVert = XInternAtom(m_display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
             Atom wmStateMaximizedHorz = XInternAtom(m_display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
@@ -599,6 +613,9 @@ void X11Window::maximize()
 
 void X11Window::poll()
 {
+    if (m_headless)
+        return;
+
     bool needsResizeUpdate = false;
 
     XEvent event, peekEvent;
@@ -861,6 +878,9 @@ void X11Window::poll()
 
 void X11Window::swapBuffers()
 {
+    if (m_headless)
+        return;
+
 #ifdef OPENGL_ES
     eglSwapBuffers(m_eglDisplay, m_eglSurface);
 #else
@@ -875,6 +895,9 @@ void X11Window::showMouse()
 
 void X11Window::hideMouse()
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&] {
         if (m_cursor != X11None)
             restoreMouseCursor();
@@ -896,6 +919,9 @@ void X11Window::hideMouse()
 
 void X11Window::setMouseCursor(int cursorId)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, cursorId] {
         if (cursorId >= (int)m_cursors.size() || cursorId < 0)
             return;
@@ -910,6 +936,9 @@ void X11Window::setMouseCursor(int cursorId)
 
 void X11Window::restoreMouseCursor()
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&] {
         XUndefineCursor(m_display, m_window);
         m_cursor = X11None;
@@ -918,6 +947,9 @@ void X11Window::restoreMouseCursor()
 
 int X11Window::internalLoadMouseCursor(const ImagePtr& image, const Point& hotSpot)
 {
+    if (m_headless)
+        return -1;
+
     int width = image->getWidth();
     int height = image->getHeight();
     int numbits = width * height;
@@ -956,6 +988,9 @@ int X11Window::internalLoadMouseCursor(const ImagePtr& image, const Point& hotSp
 
 void X11Window::setTitle(const std::string_view title)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, title = std::string{ title }] {
         XStoreName(m_display, m_window, title.data());
         XSetIconName(m_display, m_window, title.data());
@@ -964,6 +999,9 @@ void X11Window::setTitle(const std::string_view title)
 
 void X11Window::setMinimumSize(const Size& minimumSize)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, minimumSize] {
         XSizeHints sizeHints;
         memset(&sizeHints, 0, sizeof(sizeHints));
@@ -977,7 +1015,7 @@ void X11Window::setMinimumSize(const Size& minimumSize)
 void X11Window::setFullscreen(bool fullscreen)
 {
     g_mainDispatcher.addEvent([&, fullscreen] {
-        if (m_visible) {
+        if (m_visible && !m_headless) {
             Atom wmState = XInternAtom(m_display, "_NET_WM_STATE", False);
             Atom wmStateFullscreen = XInternAtom(m_display, "_NET_WM_STATE_FULLSCREEN", False);
 
@@ -1003,6 +1041,8 @@ void X11Window::setVerticalSync(bool enable)
 {
     g_mainDispatcher.addEvent([&, enable] {
         m_vsync = enable;
+        if (m_headless)
+            return;
 #ifdef OPENGL_ES
         //TODO
 #else
@@ -1022,6 +1062,9 @@ void X11Window::setVerticalSync(bool enable)
 
 void X11Window::setIcon(const std::string& file)
 {
+    if (m_headless)
+        return;
+
     g_mainDispatcher.addEvent([&, file] {
         ImagePtr image = Image::load(file);
 
@@ -1056,6 +1099,9 @@ void X11Window::setIcon(const std::string& file)
 void X11Window::setClipboardText(const std::string_view text)
 {
     m_clipboardText = text;
+    if (m_headless)
+        return;
+
     Atom clipboard = XInternAtom(m_display, "CLIPBOARD", False);
     XSetSelectionOwner(m_display, clipboard, m_window, CurrentTime);
     XFlush(m_display);
@@ -1063,11 +1109,17 @@ void X11Window::setClipboardText(const std::string_view text)
 
 Size X11Window::getDisplaySize()
 {
+    if (m_headless)
+        return m_size;
+
     return Size(XDisplayWidth(m_display, m_screen), XDisplayHeight(m_display, m_screen));
 }
 
 std::string X11Window::getClipboardText()
 {
+    if (m_headless)
+        return m_clipboardText;
+
     Atom clipboard = XInternAtom(m_display, "CLIPBOARD", False);
     Window ownerWindow = XGetSelectionOwner(m_display, clipboard);
     if (ownerWindow == m_window)
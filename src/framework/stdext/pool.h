@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace stdext
+{
+    // Allocator that parks released single object blocks in a per type free list and hands
+    // them back on the next allocation. Meant for std::allocate_shared of short lived objects
+    // created in bursts (magic effects, missiles), so the control block and the object share
+    // one recycled block instead of a heap round trip each.
+    template<typename T, size_t MaxFree = 1024>
+    class recycling_allocator
+    {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = recycling_allocator<U, MaxFree>; };
+
+        recycling_allocator() noexcept = default;
+        template<typename U>
+        recycling_allocator(const recycling_allocator<U, MaxFree>&) noexcept {}
+
+        T* allocate(const size_t n)
+        {
+            if (n == 1) {
+                if (void* block = freeList().pop())
+                    return static_cast<T*>(block);
+            }
+
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, const size_t n) noexcept
+        {
+            if (n == 1 && freeList().push(p))
+                return;
+
+            ::operator delete(p);
+        }
+
+        // blocks currently waiting to be reused
+        static size_t recycled() { return freeList().size(); }
+
+        template<typename U>
+        bool operator==(const recycling_allocator<U, MaxFree>&) const noexcept { return true; }
+
+    private:
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over aligned types are not supported");
+
+        struct FreeList
+        {
+            void* pop()
+            {
+                std::scoped_lock l(mutex);
+                if (blocks.empty())
+                    return nullptr;
+
+                void* block = blocks.back();
+                blocks.pop_back();
+                return block;
+            }
+
+            bool push(void* block)
+            {
+                std::scoped_lock l(mutex);
+                if (blocks.size() >= MaxFree)
+                    return false;
+
+                blocks.emplace_back(block);
+                return true;
+            }
+
+            size_t size()
+            {
+                std::scoped_lock l(mutex);
+                return blocks.size();
+            }
+
+            std::mutex mutex;
+            std::vector<void*> blocks;
+        };
+
+        // never destroyed: objects may still be released after static destruction begins
+        static FreeList& freeList()
+        {
+            static auto* list = new FreeList;
+            return *list;
+        }
+    };
+}
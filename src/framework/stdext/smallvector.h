@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace stdext
+{
+    // Vector that keeps up to N elements inside the object and only spills to the heap past that.
+    // Meant for members that hold a handful of elements in the common case (the things of a tile),
+    // where a std::vector pays a heap allocation and an extra pointer chase for every instance.
+    // Iterators are plain pointers and are invalidated by any growth, as with std::vector.
+    template<typename T, uint32_t N>
+    class small_vector
+    {
+        static_assert(N > 0, "small_vector needs room for at least one inline element");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        small_vector() noexcept = default;
+        small_vector(std::initializer_list<T> list) { assign(list.begin(), list.end()); }
+        small_vector(const small_vector& other) { assign(other.begin(), other.end()); }
+        small_vector(small_vector&& other) noexcept { steal(other); }
+        ~small_vector() { release(); }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other) {
+                clear();
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept
+        {
+            if (this != &other) {
+                release();
+                steal(other);
+            }
+            return *this;
+        }
+
+        iterator begin() noexcept { return m_data; }
+        iterator end() noexcept { return m_data + m_size; }
+        const_iterator begin() const noexcept { return m_data; }
+        const_iterator end() const noexcept { return m_data + m_size; }
+        const_iterator cbegin() const noexcept { return m_data; }
+        const_iterator cend() const noexcept { return m_data + m_size; }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        T& operator[](const size_t i) noexcept { return m_data[i]; }
+        const T& operator[](const size_t i) const noexcept { return m_data[i]; }
+
+        T& front() noexcept { return m_data[0]; }
+        const T& front() const noexcept { return m_data[0]; }
+        T& back() noexcept { return m_data[m_size - 1]; }
+        const T& back() const noexcept { return m_data[m_size - 1]; }
+
+        T* data() noexcept { return m_data; }
+        const T* data() const noexcept { return m_data; }
+
+        size_t size() const noexcept { return m_size; }
+        size_t capacity() const noexcept { return m_capacity; }
+        bool empty() const noexcept { return m_size == 0; }
+
+        static constexpr size_t inline_capacity() noexcept { return N; }
+        bool is_inline() const noexcept { return m_data == inlineData(); }
+
+        // bytes held outside the object, zero while the elements fit inline
+        size_t heap_bytes() const noexcept { return is_inline() ? 0 : m_capacity * sizeof(T); }
+
+        void reserve(const size_t capacity)
+        {
+            if (capacity > m_capacity)
+                grow(capacity);
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (m_size == m_capacity) {
+                // the arguments may alias an element, build the value before the storage moves
+                T value(std::forward<Args>(args)...);
+                grow(m_capacity * 2);
+                return *std::construct_at(m_data + m_size++, std::move(value));
+            }
+
+            return *std::construct_at(m_data + m_size++, std::forward<Args>(args)...);
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        void pop_back() noexcept { std::destroy_at(m_data + --m_size); }
+
+        iterator insert(const const_iterator pos, T value)
+        {
+            const size_t index = pos - m_data;
+            if (m_size == m_capacity)
+                grow(m_capacity * 2);
+
+            T* target = m_data + index;
+            if (index == m_size) {
+                std::construct_at(target, std::move(value));
+            } else {
+                std::construct_at(m_data + m_size, std::move(m_data[m_size - 1]));
+                std::move_backward(target, m_data + m_size - 1, m_data + m_size);
+                *target = std::move(value);
+            }
+
+            ++m_size;
+            return target;
+        }
+
+        iterator erase(const const_iterator pos) { return erase(pos, pos + 1); }
+
+        iterator erase(const const_iterator first, const const_iterator last)
+        {
+            T* target = m_data + (first - m_data);
+            if (first == last)
+                return target;
+
+            T* newEnd = std::move(m_data + (last - m_data), end(), target);
+            std::destroy(newEnd, end());
+            m_size = static_cast<uint32_t>(newEnd - m_data);
+            return target;
+        }
+
+        void clear() noexcept
+        {
+            std::destroy(begin(), end());
+            m_size = 0;
+        }
+
+        // returns the storage to the inline buffer when the elements fit again
+        void shrink_to_fit()
+        {
+            if (is_inline() || m_size > N)
+                return;
+
+            T* heap = m_data;
+            m_data = inlineData();
+            std::uninitialized_move(heap, heap + m_size, m_data);
+            std::destroy(heap, heap + m_size);
+            std::allocator<T>().deallocate(heap, m_capacity);
+            m_capacity = N;
+        }
+
+    private:
+        T* inlineData() noexcept { return reinterpret_cast<T*>(m_inline); }
+        const T* inlineData() const noexcept { return reinterpret_cast<const T*>(m_inline); }
+
+        template<typename It>
+        void assign(It first, const It last)
+        {
+            reserve(static_cast<size_t>(std::distance(first, last)));
+            for (; first != last; ++first)
+                std::construct_at(m_data + m_size++, *first);
+        }
+
+        void grow(const size_t capacity)
+        {
+            T* storage = std::allocator<T>().allocate(capacity);
+            std::uninitialized_move(begin(), end(), storage);
+            std::destroy(begin(), end());
+
+            if (!is_inline())
+                std::allocator<T>().deallocate(m_data, m_capacity);
+
+            m_data = storage;
+            m_capacity = static_cast<uint32_t>(capacity);
+        }
+
+        void release() noexcept
+        {
+            clear();
+            if (!is_inline())
+                std::allocator<T>().deallocate(m_data, m_capacity);
+
+            m_data = inlineData();
+            m_capacity = N;
+        }
+
+        // expects this to be empty and inline
+        void steal(small_vector& other) noexcept
+        {
+            if (other.is_inline()) {
+                std::uninitialized_move(other.begin(), other.end(), m_data);
+                m_size = other.m_size;
+                other.clear();
+                return;
+            }
+
+            m_data = std::exchange(other.m_data, other.inlineData());
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, N);
+        }
+
+        T* m_data{ inlineData() };
+        uint32_t m_size{ 0 };
+        uint32_t m_capacity{ N };
+        alignas(T) std::byte m_inline[sizeof(T) * N];
+    };
+}
@@ -29,8 +29,11 @@
 #include "demangle.h"
 #include "hash.h"
 #include "math.h"
+#include "pool.h"
+#include "smallvector.h"
 #include "qrcodegen.h"
 #include "storage.h"
 #include "string.h"
 #include "thread.h"
 #include "time.h"
+#include "timerwheel.h"
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2010-2025 OTClient <https://github.com/edubart/otclient>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "types.h"
+
+namespace stdext
+{
+    // Hashed timer wheel: deadlines are bucketed into Slots buckets of Granularity ms each and
+    // tick() only sweeps the buckets the clock walked past, so expiring thousands of short lived
+    // objects per second costs a bucket scan per frame instead of one scheduled event each.
+    // Deadlines further away than one revolution stay in their bucket until their round comes.
+    // Not thread safe, schedule and tick must run on the same thread.
+    template<typename T, size_t Slots = 256, ticks_t Granularity = 16>
+    class timer_wheel
+    {
+    public:
+        void schedule(T value, const ticks_t delay, const ticks_t now)
+        {
+            if (m_current < 0)
+                m_current = now / Granularity;
+
+            const ticks_t deadline = now + std::max<ticks_t>(delay, 0);
+
+            // round up, so an entry is never swept before its deadline
+            const ticks_t slot = std::max<ticks_t>((deadline + Granularity - 1) / Granularity, m_current + 1);
+            m_slots[slot % Slots].emplace_back(deadline, std::move(value));
+            ++m_size;
+        }
+
+        // calls onExpire for every entry whose deadline is <= now
+        template<typename F>
+        void tick(const ticks_t now, F&& onExpire)
+        {
+            if (m_current < 0 || m_size == 0) {
+                m_current = now / Granularity;
+                return;
+            }
+
+            const ticks_t target = now / Granularity;
+            const ticks_t steps = std::min<ticks_t>(target - m_current, Slots);
+            if (steps <= 0)
+                return;
+
+            // callbacks may schedule again, so collect first and fire once the buckets are settled
+            auto expired = std::move(m_expired);
+            for (ticks_t i = 1; i <= steps; ++i) {
+                auto& bucket = m_slots[(m_current + i) % Slots];
+                const auto it = std::partition(bucket.begin(), bucket.end(), [now](const Entry& e) { return e.deadline > now; });
+                for (auto expiredIt = it; expiredIt != bucket.end(); ++expiredIt)
+                    expired.emplace_back(std::move(expiredIt->value));
+                bucket.erase(it, bucket.end());
+            }
+
+            m_current = target;
+            m_size -= expired.size();
+
+            for (auto& value : expired)
+                onExpire(value);
+
+            expired.clear();
+            if (m_expired.capacity() < expired.capacity())
+                m_expired = std::move(expired);
+        }
+
+        void clear()
+        {
+            for (auto& bucket : m_slots)
+                bucket.clear();
+
+            m_size = 0;
+            m_current = -1;
+        }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+    private:
+        struct Entry
+        {
+            Entry(const ticks_t deadline, T&& value) : deadline(deadline), value(std::move(value)) {}
+
+            ticks_t deadline;
+            T value;
+        };
+
+        std::array<std::vector<Entry>, Slots> m_slots;
+        std::vector<T> m_expired;
+
+        ticks_t m_current{ -1 };
+        size_t m_size{ 0 };
+    };
+}
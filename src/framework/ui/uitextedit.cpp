@@ -75,8 +75,7 @@ void UITextEdit::drawSelf(const DrawPoolType drawPane)
     if (glyphsMustRecache)
         setProp(PropGlyphsMustRecache, false);
 
-    if (m_font->getAtlasRegion() != m_atlasRegion) {
-        m_atlasRegion = m_font->getAtlasRegion();
+    if (m_atlasRegion.update(m_font->getAtlasRegion())) {
         update(false, true);
     }
 
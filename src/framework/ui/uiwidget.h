@@ -26,6 +26,7 @@
 
 #include <framework/core/timer.h>
 #include <framework/graphics/declarations.h>
+#include <framework/graphics/textureatlas.h>
 #include <framework/html/declarations.h>
 #include <framework/luaengine/luaobject.h>
 
@@ -963,7 +964,7 @@ protected:
 
     float m_fontScale{ 1.f };
 
-    const AtlasRegion* m_atlasRegion = nullptr;
+    AtlasRegionRef m_atlasRegion;
 
 public:
     void resizeToText();
@@ -199,8 +199,7 @@ void UIWidget::drawText(const Rect& screenCoords)
         return;
 
     // Hack to fix font rendering in atlas
-    if (m_font->getAtlasRegion() != m_atlasRegion) {
-        m_atlasRegion = m_font->getAtlasRegion();
+    if (m_atlasRegion.update(m_font->getAtlasRegion())) {
         updateText();
     }
 
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include <framework/graphics/atlaspacker.h>
+
+namespace {
+
+    bool overlaps(const FreeRegion& a, const FreeRegion& b)
+    {
+        return a.layer == b.layer && a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+
+    TEST(AtlasPacker, ReleaseCoalescesBackToWholeLayer)
+    {
+        AtlasPacker packer(256, 256);
+        packer.addLayer();
+
+        std::vector<FreeRegion> regions;
+        for (int i = 0; i < 16; ++i) {
+            const auto& region = packer.allocate(64, 64);
+            ASSERT_TRUE(region.has_value());
+            regions.emplace_back(*region);
+        }
+        EXPECT_FALSE(packer.allocate(1, 1).has_value());
+
+        // release in an order that leaves neighbours apart for as long as possible
+        std::mt19937 rng(1);
+        std::shuffle(regions.begin(), regions.end(), rng);
+        for (const auto& region : regions)
+            packer.release(region);
+
+        const auto& stats = packer.getStats();
+        EXPECT_EQ(stats.usedArea, 0);
+        EXPECT_EQ(stats.freeRegions, 1);
+        EXPECT_EQ(stats.largestFreeArea, packer.getLayerArea());
+
+        const auto& whole = packer.allocate(256, 256);
+        ASSERT_TRUE(whole.has_value());
+        EXPECT_EQ(whole->layer, 0);
+    }
+
+    TEST(AtlasPacker, FreedSpaceServesOtherSizes)
+    {
+        AtlasPacker packer(128, 128);
+        packer.addLayer();
+
+        std::vector<FreeRegion> small;
+        for (int i = 0; i < 64; ++i)
+            small.emplace_back(*packer.allocate(16, 16));
+        ASSERT_FALSE(packer.allocate(64, 64).has_value());
+
+        // freeing the top half lets a texture of a size never seen before in
+        for (const auto& region : small) {
+            if (region.y < 64)
+                packer.release(region);
+        }
+
+        const auto& big = packer.allocate(128, 64);
+        ASSERT_TRUE(big.has_value());
+        for (const auto& region : small) {
+            if (region.y >= 64) {
+                EXPECT_FALSE(overlaps(*big, region));
+            }
+        }
+    }
+
+    TEST(AtlasPacker, AllocationsNeverOverlap)
+    {
+        AtlasPacker packer(512, 512);
+        packer.addLayer();
+
+        std::mt19937 rng(2);
+        std::vector<FreeRegion> live;
+        for (int step = 0; step < 4000; ++step) {
+            if (!live.empty() && rng() % 3 == 0) {
+                const size_t index = rng() % live.size();
+                packer.release(live[index]);
+                live.erase(live.begin() + index);
+                continue;
+            }
+
+            const auto& region = packer.allocate(8 + rng() % 56, 8 + rng() % 56);
+            if (!region)
+                continue;
+
+            for (const auto& other : live) {
+                ASSERT_FALSE(overlaps(*region, other));
+            }
+            ASSERT_LE(region->x + region->width, 512);
+            ASSERT_LE(region->y + region->height, 512);
+            live.emplace_back(*region);
+        }
+
+        int64_t usedArea = 0;
+        for (const auto& region : live)
+            usedArea += static_cast<int64_t>(region.width) * region.height;
+        EXPECT_EQ(packer.getStats().usedArea, usedArea);
+    }
+
+    TEST(AtlasPacker, StatsReportOccupancyAndFragmentation)
+    {
+        AtlasPacker packer(100, 100);
+        packer.addLayer();
+        packer.addLayer();
+
+        packer.allocate(50, 100);
+
+        const auto& stats = packer.getStats();
+        EXPECT_EQ(stats.layers, 2);
+        EXPECT_EQ(stats.totalArea, 20000);
+        EXPECT_EQ(stats.usedArea, 5000);
+        EXPECT_FLOAT_EQ(stats.occupancy(), 0.25f);
+        EXPECT_EQ(stats.largestFreeArea, 10000);
+        EXPECT_FLOAT_EQ(stats.fragmentation(), 1.f - 10000.f / 15000.f);
+        ASSERT_EQ(stats.layerUsedArea.size(), 2u);
+        EXPECT_EQ(stats.layerUsedArea[0] + stats.layerUsedArea[1], 5000);
+    }
+
+    TEST(AtlasPacker, PackUsesFewerLayersThanSparseAtlas)
+    {
+        AtlasPacker packer(128, 128);
+        std::vector<std::pair<int, int>> sizes;
+        for (int i = 0; i < 8; ++i)
+            sizes.emplace_back(32, 64);
+        for (int i = 0; i < 16; ++i)
+            sizes.emplace_back(32, 32);
+
+        const auto& placements = packer.pack(sizes);
+        ASSERT_TRUE(placements.has_value());
+        ASSERT_EQ(placements->size(), sizes.size());
+        EXPECT_EQ(packer.getLayerCount(), 2);
+
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            EXPECT_EQ((*placements)[i].width, sizes[i].first);
+            EXPECT_EQ((*placements)[i].height, sizes[i].second);
+            for (size_t j = i + 1; j < sizes.size(); ++j) {
+                EXPECT_FALSE(overlaps((*placements)[i], (*placements)[j]));
+            }
+        }
+    }
+
+    TEST(AtlasPacker, PackRejectsOversizedTextures)
+    {
+        AtlasPacker packer(64, 64);
+        EXPECT_FALSE(packer.pack({ { 32, 32 }, { 65, 10 } }).has_value());
+    }
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <framework/graphics/coordsbuffer.h>
+
+namespace {
+    constexpr int ITERATIONS = 200;
+    constexpr int RECTS = 4096;
+
+    // the separate position and texture coordinate arrays the interleaved buffer replaced
+    struct SplitBuffer
+    {
+        std::vector<float> vertices;
+        std::vector<float> textureCoords;
+
+        static void addRect(std::vector<float>& buffer, const Rect& rect)
+        {
+            const float top = rect.top();
+            const float right = rect.right() + 1;
+            const float bottom = rect.bottom() + 1;
+            const float left = rect.left();
+
+            const float arr[] = { left, top, right, top, left, bottom, left, bottom, right, top, right, bottom };
+            buffer.insert(buffer.end(), std::begin(arr), std::end(arr));
+        }
+
+        void addRect(const Rect& dest, const Rect& src)
+        {
+            addRect(vertices, dest);
+            if (src.isValid())
+                addRect(textureCoords, src);
+        }
+
+        void clear()
+        {
+            vertices.clear();
+            textureCoords.clear();
+        }
+    };
+
+    template<typename F>
+    double measureMs(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i)
+            f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+// split arrays vs interleaved buffer timings of addRect for a frame worth of sprites
+int main()
+{
+    std::mt19937 rng(4);
+    std::vector<std::pair<Rect, Rect>> rects;
+    for (int i = 0; i < RECTS; ++i) {
+        const Rect dest(static_cast<int>(rng() % 2048), static_cast<int>(rng() % 2048), static_cast<int>(rng() % 96 + 1), static_cast<int>(rng() % 96 + 1));
+        const Rect src(static_cast<int>(rng() % 2048), static_cast<int>(rng() % 2048), static_cast<int>(rng() % 96 + 1), static_cast<int>(rng() % 96 + 1));
+        rects.emplace_back(dest, src);
+    }
+
+    SplitBuffer splitBuffer;
+    CoordsBuffer buffer;
+
+    const double splitMs = measureMs([&] {
+        splitBuffer.clear();
+        for (const auto& [dest, src] : rects)
+            splitBuffer.addRect(dest, src);
+    });
+    const double currentMs = measureMs([&] {
+        buffer.clear();
+        for (const auto& [dest, src] : rects)
+            buffer.addRect(dest, src);
+    });
+
+    std::cout << "addRect: split arrays " << splitMs << " ms, interleaved " << currentMs
+        << " ms (x" << (currentMs > 0 ? splitMs / currentMs : 0) << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <framework/graphics/coordsbuffer.h>
+
+namespace {
+
+    Rect makeRect(std::mt19937& rng)
+    {
+        return { static_cast<int>(rng() % 2048) - 64, static_cast<int>(rng() % 2048) - 64, static_cast<int>(rng() % 96 + 1), static_cast<int>(rng() % 96 + 1) };
+    }
+
+    // a rect is two triangles: top left, top right, bottom left, then bottom left, top right, bottom right
+    void expectCorners(const float* array, const int first, const Rect& rect)
+    {
+        const float left = rect.left();
+        const float top = rect.top();
+        const float right = rect.right() + 1;
+        const float bottom = rect.bottom() + 1;
+        const float corners[6][2] = { { left, top }, { right, top }, { left, bottom }, { left, bottom }, { right, top }, { right, bottom } };
+
+        const int stride = CoordsBuffer::STRIDE / sizeof(float);
+        for (int i = 0; i < 6; ++i) {
+            EXPECT_EQ(array[(first + i) * stride], corners[i][0]);
+            EXPECT_EQ(array[(first + i) * stride + 1], corners[i][1]);
+        }
+    }
+
+    TEST(CoordsBuffer, TexturedRectsWriteDestAndSourceCorners)
+    {
+        std::mt19937 rng(1);
+
+        std::vector<std::pair<Rect, Rect>> rects;
+        CoordsBuffer buffer(4);
+        for (int i = 0; i < 500; ++i) {
+            const auto& rect = rects.emplace_back(makeRect(rng), makeRect(rng));
+            buffer.addRect(rect.first, rect.second);
+        }
+
+        ASSERT_EQ(buffer.getVertexCount(), 500 * 6);
+        ASSERT_EQ(buffer.getTextureCoordCount(), buffer.getVertexCount());
+        for (int i = 0; i < 500; ++i) {
+            expectCorners(buffer.getVertexArray(), i * 6, rects[i].first);
+            expectCorners(buffer.getTextureCoordArray(), i * 6, rects[i].second);
+        }
+    }
+
+    TEST(CoordsBuffer, UntexturedRectsHaveNoTextureCoords)
+    {
+        std::mt19937 rng(2);
+
+        std::vector<Rect> rects;
+        CoordsBuffer buffer;
+        for (int i = 0; i < 50; ++i)
+            buffer.addRect(rects.emplace_back(makeRect(rng)), Rect());
+
+        ASSERT_EQ(buffer.getVertexCount(), 50 * 6);
+        EXPECT_EQ(buffer.getTextureCoordCount(), 0);
+        for (int i = 0; i < 50; ++i)
+            expectCorners(buffer.getVertexArray(), i * 6, rects[i]);
+    }
+
+    TEST(CoordsBuffer, ClearKeepsStorageAndAppendCopies)
+    {
+        std::mt19937 rng(3);
+
+        CoordsBuffer buffer;
+        for (int i = 0; i < 100; ++i)
+            buffer.addRect(makeRect(rng), makeRect(rng));
+
+        const float* storage = buffer.getVertexArray();
+        buffer.clear();
+        EXPECT_EQ(buffer.getVertexCount(), 0);
+        EXPECT_EQ(buffer.getTextureCoordCount(), 0);
+
+        std::vector<std::pair<Rect, Rect>> rects;
+        CoordsBuffer other;
+        for (int i = 0; i < 100; ++i) {
+            const auto& rect = rects.emplace_back(makeRect(rng), makeRect(rng));
+            other.addRect(rect.first, rect.second);
+        }
+
+        buffer.append(&other);
+        EXPECT_EQ(buffer.getVertexArray(), storage);
+        ASSERT_EQ(buffer.getVertexCount(), 100 * 6);
+        ASSERT_EQ(buffer.getTextureCoordCount(), buffer.getVertexCount());
+        for (int i = 0; i < 100; ++i) {
+            expectCorners(buffer.getVertexArray(), i * 6, rects[i].first);
+            expectCorners(buffer.getTextureCoordArray(), i * 6, rects[i].second);
+        }
+    }
+
+    TEST(CoordsBuffer, RepeatedRectsCoverDestination)
+    {
+        CoordsBuffer buffer;
+        buffer.addRepeatedRects(Rect(10, 20, 70, 40), Rect(0, 0, 32, 32));
+
+        // 3 columns by 2 rows, the last ones clipped to the destination
+        ASSERT_EQ(buffer.getVertexCount(), 6 * 6);
+        EXPECT_EQ(buffer.getTextureCoordCount(), buffer.getVertexCount());
+
+        const int stride = CoordsBuffer::STRIDE / sizeof(float);
+        float right = 0, bottom = 0;
+        for (int i = 0; i < buffer.getVertexCount(); ++i) {
+            right = std::max(right, buffer.getVertexArray()[i * stride]);
+            bottom = std::max(bottom, buffer.getVertexArray()[i * stride + 1]);
+        }
+        EXPECT_EQ(right, 80.f);
+        EXPECT_EQ(bottom, 60.f);
+    }
+
+    TEST(CoordsBuffer, TranslateMovesPositionsOnly)
+    {
+        std::mt19937 rng(5);
+
+        std::vector<std::pair<Rect, Rect>> rects;
+        CoordsBuffer moved;
+        for (int i = 0; i < 20; ++i) {
+            const auto& rect = rects.emplace_back(makeRect(rng), makeRect(rng));
+            moved.addRect(rect.first, rect.second);
+        }
+
+        moved.translate(Point(7, -3));
+        for (int i = 0; i < 20; ++i) {
+            expectCorners(moved.getVertexArray(), i * 6, rects[i].first.translated(7, -3));
+            expectCorners(moved.getTextureCoordArray(), i * 6, rects[i].second);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+#include "image_kernels_reference.h"
+
+using namespace image_kernels;
+
+namespace {
+    constexpr int ITERATIONS = 200;
+
+    template<typename F>
+    double measureMs(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i)
+            f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const std::string_view name, const double legacyMs, const double currentMs)
+    {
+        std::cout << name << ": legacy " << legacyMs << " ms, current " << currentMs
+            << " ms (x" << (currentMs > 0 ? legacyMs / currentMs : 0) << ")" << std::endl;
+    }
+}
+
+// legacy vs current timings of the image kernels for a typical outfit texture build
+int main()
+{
+    const auto& base = makeImage(Size(256, 256), 8);
+    const auto& layer = makeImage(Size(64, 64), 9);
+    const Color masked(255, 255, 0, 255);
+
+    auto target = copyImage(base);
+    report("overwriteMask", measureMs([&] { legacy::overwriteMask(*target, masked, Color::white, Color::alpha); }),
+           measureMs([&] { target->overwriteMask(masked); }));
+
+    report("blit", measureMs([&] { for (int i = 0; i < 16; ++i) legacy::blit(*target, Point(i % 4 * 64, i / 4 * 64), layer); }),
+           measureMs([&] { for (int i = 0; i < 16; ++i) target->blit(Point(i % 4 * 64, i / 4 * 64), layer); }));
+
+    report("paste", measureMs([&] { legacy::paste(*target, layer); }),
+           measureMs([&] { target->paste(layer); }));
+
+    report("setOpacity", measureMs([&] { legacy::setOpacity(*target, 128); }),
+           measureMs([&] { target->setOpacity(128); }));
+
+    report("flipVertically", measureMs([&] { legacy::flipVertically(*target); }),
+           measureMs([&] { target->flipVertically(); }));
+
+    return 0;
+}
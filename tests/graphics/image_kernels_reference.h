@@ -0,0 +1,104 @@
+#pragma once
+
+#include <random>
+
+#include <framework/graphics/image.h>
+
+// shared by the image kernel tests and the opt-in image kernel benchmark
+namespace image_kernels
+{
+    // Per pixel implementations the word based kernels replaced, kept as reference.
+    namespace legacy {
+        inline void overwriteMask(Image& image, const Color& maskedColor, const Color& insideColor, const Color& outsideColor)
+        {
+            auto& pixels = image.getPixels();
+            for (int p = 0; p < image.getPixelCount(); ++p) {
+                uint8_t& r = pixels[p * 4 + 0];
+                uint8_t& g = pixels[p * 4 + 1];
+                uint8_t& b = pixels[p * 4 + 2];
+                uint8_t& a = pixels[p * 4 + 3];
+
+                const Color pixelColor(r, g, b, a);
+                const Color writeColor = (pixelColor == maskedColor) ? insideColor : outsideColor;
+
+                r = writeColor.r();
+                g = writeColor.g();
+                b = writeColor.b();
+                a = writeColor.a();
+            }
+        }
+
+        inline void blit(Image& image, const Point& dest, const ImagePtr& other)
+        {
+            auto& pixels = image.getPixels();
+            const uint8_t* otherPixels = other->getPixelData();
+            for (int p = 0; p < other->getPixelCount(); ++p) {
+                const int x = p % other->getWidth();
+                const int y = p / other->getWidth();
+                const int pos = ((dest.y + y) * image.getWidth() + (dest.x + x)) * 4;
+
+                if (otherPixels[p * 4 + 3] != 0) {
+                    pixels[pos + 0] = otherPixels[p * 4 + 0];
+                    pixels[pos + 1] = otherPixels[p * 4 + 1];
+                    pixels[pos + 2] = otherPixels[p * 4 + 2];
+                    pixels[pos + 3] = otherPixels[p * 4 + 3];
+                }
+            }
+        }
+
+        inline void paste(Image& image, const ImagePtr& other)
+        {
+            auto& pixels = image.getPixels();
+            const uint8_t* otherPixels = other->getPixelData();
+            for (int p = 0; p < other->getPixelCount(); ++p) {
+                const int x = p % other->getWidth();
+                const int y = p / other->getWidth();
+                const int pos = (y * image.getWidth() + x) * 4;
+
+                pixels[pos + 0] = otherPixels[p * 4 + 0];
+                pixels[pos + 1] = otherPixels[p * 4 + 1];
+                pixels[pos + 2] = otherPixels[p * 4 + 2];
+                pixels[pos + 3] = otherPixels[p * 4 + 3];
+            }
+        }
+
+        inline void setOpacity(Image& image, const uint8_t v)
+        {
+            auto& pixels = image.getPixels();
+            for (size_t i = 3, s = pixels.size(); i < s; i += 4)
+                pixels[i] = v;
+        }
+
+        inline void flipVertically(Image& image)
+        {
+            auto& pixels = image.getPixels();
+            for (int line = 0, h = image.getHeight(), w = image.getWidth(); line != h / 2; ++line) {
+                std::swap_ranges(
+                    pixels.begin() + 4 * w * line,
+                    pixels.begin() + 4 * w * (line + 1),
+                    pixels.begin() + 4 * w * (h - line - 1));
+            }
+        }
+    }
+
+    // sprite like content: transparent holes and a handful of mask colors
+    inline ImagePtr makeImage(const Size& size, const uint32_t seed)
+    {
+        static constexpr uint32_t palette[] = { 0x00000000, 0xff00ffff, 0xff0000ff, 0xff00ff00, 0xffff0000, 0xff808080 };
+
+        std::mt19937 rng(seed);
+        const auto& image = std::make_shared<Image>(size);
+        for (int y = 0; y < size.height(); ++y) {
+            for (int x = 0; x < size.width(); ++x) {
+                const uint32_t rgba = rng() % 3 == 0 ? static_cast<uint32_t>(rng()) : palette[rng() % std::size(palette)];
+                image->setPixel(x, y, rgba);
+            }
+        }
+        return image;
+    }
+
+    inline ImagePtr copyImage(const ImagePtr& image)
+    {
+        return std::make_shared<Image>(image->getSize(), image->getBpp(), image->getPixelData());
+    }
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "image_kernels_reference.h"
+
+namespace {
+    using namespace image_kernels;
+
+    // odd sizes leave pixels after the last four pixel block of a row or image
+    TEST(ImageKernels, OverwriteMaskMatchesLegacy)
+    {
+        for (const auto& size : { Size(64, 64), Size(31, 17) }) {
+            const auto& source = makeImage(size, 1);
+            const Color masked(255, 255, 0, 255);
+
+            const auto& expected = copyImage(source);
+            legacy::overwriteMask(*expected, masked, Color::white, Color::alpha);
+
+            const auto& actual = copyImage(source);
+            actual->overwriteMask(masked);
+
+            EXPECT_EQ(actual->getPixels(), expected->getPixels());
+        }
+    }
+
+    TEST(ImageKernels, BlitMatchesLegacy)
+    {
+        for (const auto& size : { Size(32, 32), Size(13, 7) }) {
+            const auto& base = makeImage(Size(96, 96), 2);
+            const auto& layer = makeImage(size, 3);
+
+            const auto& expected = copyImage(base);
+            legacy::blit(*expected, Point(17, 40), layer);
+
+            const auto& actual = copyImage(base);
+            actual->blit(Point(17, 40), layer);
+
+            EXPECT_EQ(actual->getPixels(), expected->getPixels());
+        }
+    }
+
+    TEST(ImageKernels, PasteMatchesLegacy)
+    {
+        const auto& base = makeImage(Size(64, 48), 4);
+        const auto& layer = makeImage(Size(32, 32), 5);
+
+        const auto& expected = copyImage(base);
+        legacy::paste(*expected, layer);
+
+        const auto& actual = copyImage(base);
+        actual->paste(layer);
+
+        EXPECT_EQ(actual->getPixels(), expected->getPixels());
+    }
+
+    TEST(ImageKernels, SetOpacityMatchesLegacy)
+    {
+        const auto& source = makeImage(Size(33, 17), 6);
+
+        const auto& expected = copyImage(source);
+        legacy::setOpacity(*expected, 77);
+
+        const auto& actual = copyImage(source);
+        actual->setOpacity(77);
+
+        EXPECT_EQ(actual->getPixels(), expected->getPixels());
+    }
+
+    TEST(ImageKernels, FlipVerticallyMatchesLegacy)
+    {
+        for (const auto& size : { Size(32, 32), Size(31, 17) }) {
+            const auto& source = makeImage(size, 7);
+
+            const auto& expected = copyImage(source);
+            legacy::flipVertically(*expected);
+
+            const auto& actual = copyImage(source);
+            actual->flipVertically();
+
+            EXPECT_EQ(actual->getPixels(), expected->getPixels());
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <framework/stdext/smallvector.h>
+
+namespace {
+
+    template<typename T, uint32_t N>
+    std::vector<T> toVector(const stdext::small_vector<T, N>& values)
+    {
+        return { values.begin(), values.end() };
+    }
+
+    TEST(SmallVector, StaysInlineUpToCapacity)
+    {
+        stdext::small_vector<std::shared_ptr<int>, 3> values;
+        for (int i = 0; i < 3; ++i)
+            values.emplace_back(std::make_shared<int>(i));
+
+        EXPECT_TRUE(values.is_inline());
+        EXPECT_EQ(values.heap_bytes(), 0u);
+        EXPECT_EQ(*values.front(), 0);
+        EXPECT_EQ(*values.back(), 2);
+    }
+
+    TEST(SmallVector, SpillsToHeapAndBack)
+    {
+        stdext::small_vector<std::string, 2> values;
+        for (int i = 0; i < 5; ++i)
+            values.emplace_back(std::to_string(i));
+
+        EXPECT_FALSE(values.is_inline());
+        EXPECT_GE(values.capacity(), 5u);
+        EXPECT_EQ(toVector(values), (std::vector<std::string>{ "0", "1", "2", "3", "4" }));
+
+        values.erase(values.begin() + 1, values.end() - 1);
+        values.shrink_to_fit();
+        EXPECT_TRUE(values.is_inline());
+        EXPECT_EQ(toVector(values), (std::vector<std::string>{ "0", "4" }));
+    }
+
+    TEST(SmallVector, InsertAndEraseKeepOrder)
+    {
+        stdext::small_vector<int, 3> values{ 1, 3 };
+        values.insert(values.begin() + 1, 2);
+        values.insert(values.begin(), 0);
+        values.insert(values.end(), 4);
+        EXPECT_EQ(toVector(values), (std::vector<int>{ 0, 1, 2, 3, 4 }));
+
+        values.erase(values.begin() + 2);
+        values.erase(values.begin());
+        EXPECT_EQ(toVector(values), (std::vector<int>{ 1, 3, 4 }));
+
+        std::vector<int> reversed;
+        for (const int value : std::ranges::reverse_view(values))
+            reversed.emplace_back(value);
+        EXPECT_EQ(reversed, (std::vector<int>{ 4, 3, 1 }));
+    }
+
+    TEST(SmallVector, GrowthHandlesAliasedArguments)
+    {
+        stdext::small_vector<std::string, 1> values{ "first" };
+        values.push_back(values[0]);
+        values.insert(values.begin(), values.back());
+        EXPECT_EQ(toVector(values), (std::vector<std::string>{ "first", "first", "first" }));
+    }
+
+    TEST(SmallVector, CopyAndMoveReleaseOwnership)
+    {
+        const auto shared = std::make_shared<int>(7);
+        {
+            stdext::small_vector<std::shared_ptr<int>, 2> inlineValues{ shared };
+            stdext::small_vector<std::shared_ptr<int>, 2> heapValues{ shared, shared, shared };
+
+            auto copy = heapValues;
+            EXPECT_EQ(shared.use_count(), 8);
+
+            auto movedInline = std::move(inlineValues);
+            auto movedHeap = std::move(heapValues);
+            EXPECT_TRUE(inlineValues.empty());
+            EXPECT_TRUE(heapValues.empty());
+            EXPECT_TRUE(heapValues.is_inline());
+            EXPECT_EQ(movedHeap.size(), 3u);
+
+            copy = std::move(movedInline);
+            EXPECT_EQ(copy.size(), 1u);
+            EXPECT_EQ(shared.use_count(), 5);
+
+            copy.clear();
+            EXPECT_EQ(shared.use_count(), 4);
+        }
+        EXPECT_EQ(shared.use_count(), 1);
+    }
+}
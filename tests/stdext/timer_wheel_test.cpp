@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <framework/stdext/pool.h>
+#include <framework/stdext/timerwheel.h>
+
+namespace {
+
+    std::vector<int> tickAt(stdext::timer_wheel<int>& wheel, const ticks_t now)
+    {
+        std::vector<int> fired;
+        wheel.tick(now, [&](const int value) { fired.emplace_back(value); });
+        return fired;
+    }
+
+    TEST(TimerWheel, FiresAtDeadlineNeverBefore)
+    {
+        stdext::timer_wheel<int> wheel;
+        wheel.schedule(1, 100, 1000);
+        wheel.schedule(2, 35, 1000);
+
+        EXPECT_TRUE(tickAt(wheel, 1034).empty());
+        EXPECT_EQ(tickAt(wheel, 1050), std::vector<int>{ 2 });
+        EXPECT_TRUE(tickAt(wheel, 1099).empty());
+        EXPECT_EQ(tickAt(wheel, 1120), std::vector<int>{ 1 });
+        EXPECT_TRUE(wheel.empty());
+    }
+
+    TEST(TimerWheel, ZeroDelayFiresOnNextTick)
+    {
+        stdext::timer_wheel<int> wheel;
+        wheel.tick(1000, [](int) {});
+        wheel.schedule(7, 0, 1000);
+
+        EXPECT_EQ(tickAt(wheel, 1016), std::vector<int>{ 7 });
+    }
+
+    TEST(TimerWheel, KeepsDeadlinesBeyondOneRevolution)
+    {
+        // 256 slots of 16ms cover about 4s
+        stdext::timer_wheel<int> wheel;
+        wheel.schedule(1, 10000, 0);
+        wheel.schedule(2, 20, 0);
+
+        EXPECT_EQ(tickAt(wheel, 5000), std::vector<int>{ 2 });
+        EXPECT_TRUE(tickAt(wheel, 9999).empty());
+        EXPECT_EQ(tickAt(wheel, 10000), std::vector<int>{ 1 });
+    }
+
+    TEST(TimerWheel, LongGapSweepsEverything)
+    {
+        stdext::timer_wheel<int> wheel;
+        for (int i = 0; i < 1000; ++i)
+            wheel.schedule(i, i * 3, 0);
+
+        EXPECT_EQ(tickAt(wheel, 60000).size(), 1000u);
+        EXPECT_TRUE(wheel.empty());
+    }
+
+    TEST(TimerWheel, CallbackMayScheduleAndClear)
+    {
+        stdext::timer_wheel<int> wheel;
+        wheel.schedule(1, 10, 0);
+
+        int calls = 0;
+        wheel.tick(20, [&](int) { ++calls; wheel.schedule(2, 10, 20); });
+        EXPECT_EQ(wheel.size(), 1u);
+        EXPECT_EQ(tickAt(wheel, 40), std::vector<int>{ 2 });
+
+        wheel.schedule(3, 10, 40);
+        wheel.clear();
+        EXPECT_TRUE(tickAt(wheel, 100).empty());
+        EXPECT_EQ(calls, 1);
+    }
+
+    struct Pooled
+    {
+        int payload[8]{};
+    };
+
+    TEST(RecyclingAllocator, ReusesReleasedBlocks)
+    {
+        using Allocator = stdext::recycling_allocator<Pooled>;
+
+        const void* first;
+        {
+            const auto object = std::allocate_shared<Pooled>(Allocator());
+            first = object.get();
+        }
+
+        const auto object = std::allocate_shared<Pooled>(Allocator());
+        EXPECT_EQ(object.get(), first);
+    }
+}